@@ -709,7 +709,19 @@ _ODP_INLINE odp_packet_t odp_packet_ref_static(odp_packet_t pkt)
 
 _ODP_INLINE int odp_packet_has_ref(odp_packet_t pkt)
 {
-	return (rte_mbuf_refcnt_read((struct rte_mbuf *)(pkt)) > 1);
+	struct rte_mbuf *mb = (struct rte_mbuf *)pkt;
+
+	/* Data of indirect segments is owned by the direct mbuf they are attached to */
+	do {
+		struct rte_mbuf *md = RTE_MBUF_DIRECT(mb) ? mb : rte_mbuf_from_indirect(mb);
+
+		if (rte_mbuf_refcnt_read(md) > 1)
+			return 1;
+
+		mb = mb->next;
+	} while (mb != NULL);
+
+	return 0;
 }
 
 _ODP_INLINE odp_packet_color_t odp_packet_color(odp_packet_t pkt)
@@ -0,0 +1,43 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2025 Nokia
+ */
+
+/**
+ * @file
+ *
+ * ODP DMA - implementation internal
+ */
+
+#ifndef ODP_DMA_INTERNAL_H_
+#define ODP_DMA_INTERNAL_H_
+
+#include <odp/api/hints.h>
+#include <odp/api/packet.h>
+#include <odp/api/std_types.h>
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Minimum length of packet copies offloaded to DMA, zero when disabled */
+extern uint32_t _odp_dma_pkt_copy_min_len;
+
+/* Check if a packet copy of 'len' bytes should be offloaded to DMA */
+static inline odp_bool_t _odp_dma_pkt_copy_offload(uint32_t len)
+{
+	return odp_unlikely(_odp_dma_pkt_copy_min_len && len >= _odp_dma_pkt_copy_min_len);
+}
+
+/* Copy data between two different packets using the internal DMA device.
+ * Returns 0 on success. On failure, destination data is undefined and the
+ * copy has to be redone by the caller. */
+int _odp_dma_pkt_copy(odp_packet_t dst, uint32_t dst_offset, odp_packet_t src,
+		      uint32_t src_offset, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
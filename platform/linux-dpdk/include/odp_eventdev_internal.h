@@ -50,6 +50,9 @@ ODP_STATIC_ASSERT(MAX_SCHED_BURST <= UINT16_MAX,
 /* Number of scheduling groups */
 #define NUM_SCHED_GRPS 32
 
+/* Maximum number of event timer adapters */
+#define MAX_TIMER_ADAPTERS 32
+
 ODP_STATIC_ASSERT(sizeof(((struct rte_event *)0)->queue_id) == sizeof(uint8_t),
 		  "eventdev queue ID size changed");
 
@@ -95,15 +98,45 @@ typedef struct {
 		uint8_t id;
 		uint8_t single_queue;
 	} rx_adapter;
+	struct {
+		/* Crypto adapter use enabled in config file */
+		uint8_t enabled;
+	} crypto_adapter;
+	struct {
+		odp_ticketlock_t lock;
+		/* Tx adapter use enabled in config file */
+		uint8_t enabled;
+		uint8_t running;
+		uint8_t id;
+		/* Eventdev queue reserved for transmitted packets */
+		uint8_t queue_id;
+		/* Workers enqueue packets directly to the adapter */
+		uint8_t internal_port;
+	} tx_adapter;
+	struct {
+		/* Number of event ports reserved for timer adapters */
+		uint8_t num_ports;
+		/* First reserved event port, follows the worker ports */
+		uint8_t first_port;
+	} timer_adapter;
 	odp_atomic_u32_t num_started;
+	/* Number of threads which have enqueued events */
+	odp_atomic_u32_t num_enq_started;
 	uint8_t     dev_id;
 	uint8_t     num_event_ports;
 	uint8_t     num_prio;
 
 	struct {
+		odp_ticketlock_t lock;
 		uint8_t num_atomic;
 		uint8_t num_ordered;
 		uint8_t num_parallel;
+		/* Number of eventdev queues used for ODP scheduled queues */
+		uint8_t num_queues;
+		/* Schedule types are not statically divided in config file */
+		uint8_t dynamic;
+		/* Eventdev queues support all schedule types */
+		uint8_t all_types;
 	} event_queue;
 	pktio_entry_t *pktio[RTE_MAX_ETHPORTS];
 
@@ -146,6 +179,7 @@ typedef struct {
 	uint8_t port_id;
 	uint8_t paused;
 	uint8_t started;
+	uint8_t enq_started;
 } eventdev_local_t;
 
 extern eventdev_global_t *_odp_eventdev_gbl;
@@ -161,6 +195,25 @@ void _odp_rx_adapter_port_stop(uint16_t port_id);
 
 int _odp_rx_adapter_close(void);
 
+int _odp_tx_adapter_port_add(uint16_t port_id);
+
+void _odp_tx_adapter_port_del(uint16_t port_id);
+
+int _odp_tx_adapter_close(void);
+
+/* Enqueue packets to Tx adapter. Mbuf port and Tx queue must be set by the
+ * caller. Tx queue index is used as the flow ID to maintain packet order
+ * per Tx queue. */
+int _odp_tx_adapter_enq(struct rte_mbuf *mbuf[], int num, uint16_t txq);
+
+/* Finish a crypto operation received from crypto adapter and return
+ * the resulting packet event */
+odp_event_t _odp_crypto_adapter_event(void *crypto_op);
+
+/* Mark a timer expired by timer adapter and return its timeout event. Returns
+ * ODP_EVENT_INVALID if the timer has been cancelled meanwhile. */
+odp_event_t _odp_timer_adapter_event(void *timer);
+
 static inline uint8_t event_schedule_type(odp_schedule_sync_t sync)
 {
 	/* Ordered queues implemented using atomic queues */
@@ -6,6 +6,7 @@
 #include <odp_posix_extensions.h>
 
 #include <odp/api/align.h>
+#include <odp/api/atomic.h>
 #include <odp/api/buffer.h>
 #include <odp/api/crypto.h>
 #include <odp/api/debug.h>
@@ -14,7 +15,9 @@
 #include <odp/api/shared_memory.h>
 #include <odp/api/spinlock.h>
 #include <odp/api/packet.h>
+#include <odp/api/queue.h>
 #include <odp/api/random.h>
+#include <odp/api/thread.h>
 #include <odp/api/time.h>
 
 #include <odp/api/plat/packet_inlines.h>
@@ -22,11 +25,13 @@
 
 #include <odp_crypto_internal.h>
 #include <odp_debug_internal.h>
+#include <odp_eventdev_internal.h>
 #include <odp_global_data.h>
 #include <odp_init_internal.h>
 #include <odp_packet_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_libconfig_internal.h>
+#include <odp_schedule_if.h>
 
 /* Inlined API functions */
 #include <odp/api/plat/event_inlines.h>
@@ -35,8 +40,11 @@
 #include <rte_config.h>
 #include <rte_crypto.h>
 #include <rte_cryptodev.h>
+#include <rte_event_crypto_adapter.h>
 #include <rte_malloc.h>
 
+#include <errno.h>
+#include <inttypes.h>
 #include <string.h>
 #include <math.h>
 
@@ -63,6 +71,13 @@ ODP_STATIC_ASSERT(NB_DESC_PER_QUEUE_PAIR > MAX_BURST,
 /* Required by crypto_aesni_mb driver */
 ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(NB_DESC_PER_QUEUE_PAIR),
 		  "NB_DESC_PER_QUEUE_PAIR must be a power of 2");
+/*
+ * In asynchronous enqueue mode operations stay in the queue pairs until
+ * completions are polled, so more descriptors are needed.
+ */
+#define NB_DESC_PER_QUEUE_PAIR_ASYNC (8 * MAX_BURST)
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(NB_DESC_PER_QUEUE_PAIR_ASYNC),
+		  "NB_DESC_PER_QUEUE_PAIR_ASYNC must be a power of 2");
 
 #define MAX_IV_LENGTH 16
 #define AES_CCM_AAD_OFFSET 18
@@ -74,11 +89,25 @@ ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(NB_DESC_PER_QUEUE_PAIR),
 
 #define MAX_CRYPTODEVS 16
 
+#define CRYPTO_ADAPTER_ID 0
+
+typedef struct ODP_ALIGNED_CACHE crypto_qpair_s {
+	/* Protects queue pair access when it may be used by multiple threads */
+	odp_spinlock_t lock;
+
+	/* Number of asynchronous operations in the queue pair */
+	odp_atomic_u32_t num_async;
+
+} crypto_qpair_t;
+
 typedef struct cryptodev_s {
 	uint8_t dev_id;
 	odp_bool_t disable_aes_cmac;
 	odp_bool_t qpairs_shared;
 	uint16_t num_qpairs;
+	/* Queue pair 'num_qpairs' is serviced by eventdev crypto adapter */
+	odp_bool_t adapter;
+	crypto_qpair_t *qpair;
 } cryptodev_t;
 
 typedef struct crypto_session_entry_s {
@@ -88,9 +117,10 @@ typedef struct crypto_session_entry_s {
 	odp_crypto_session_param_t p;
 	struct rte_cryptodev_sym_session *rte_session;
 	struct {
-		unsigned int cdev_qpairs_shared:1;
 		unsigned int chained_bufs_ok:1;
 		unsigned int aead:1;
+		unsigned int async:1;
+		unsigned int adapter:1;
 	} flags;
 	uint8_t cdev_id;
 	cryptodev_t *dev;
@@ -100,6 +130,7 @@ typedef struct crypto_config_s {
 	uint32_t max_sessions;
 	odp_bool_t allow_queue_pair_sharing;
 	odp_bool_t openssl_disable_aes_cmac;
+	odp_bool_t async_enq;
 } crypto_config_t;
 
 typedef struct crypto_global_s {
@@ -109,6 +140,8 @@ typedef struct crypto_global_s {
 	struct rte_mempool *crypto_op_pool;
 	struct rte_mempool *session_mempool[RTE_MAX_NUMA_NODES];
 	odp_shm_t shm;
+	/* Eventdev crypto adapter delivers completion events */
+	odp_bool_t adapter_running;
 	crypto_config_t config;
 	crypto_session_entry_t *free;
 	crypto_session_entry_t sessions[];
@@ -118,6 +151,7 @@ typedef enum op_status_t {
 	S_OK,		/* everything ok this far */
 	S_NOP,		/* no-op: null crypto & null auth */
 	S_DEV,		/* processed by cryptodev */
+	S_DEV_ASYNC,	/* enqueued to cryptodev, completion delivered later */
 	S_ERROR,	/* error occurred */
 	S_ERROR_LIN,	/* packet linearization error occurred */
 	S_ERROR_HASH_OFFSET, /* hash offset in cipher range */
@@ -145,6 +179,9 @@ typedef struct crypto_op_t {
 
 static crypto_global_t *global;
 
+/* Round robin index for polling queue pairs of other threads */
+static __thread uint32_t poll_idx;
+
 static inline int is_valid_size(uint16_t length,
 				const struct rte_crypto_param_range *range)
 {
@@ -371,10 +408,159 @@ static int read_config(crypto_config_t *config)
 	config->openssl_disable_aes_cmac = !!val;
 	_ODP_PRINT("  %s: %d\n", str, val);
 
+	str = "crypto.async_enq";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	config->async_enq = !!val;
+	_ODP_PRINT("  %s: %d\n", str, val);
+
 	_ODP_PRINT("\n");
 	return 0;
 }
 
+/* Check if eventdev crypto adapter should be used with the current scheduler */
+static odp_bool_t crypto_adapter_requested(void)
+{
+	return _odp_sched_id == _ODP_SCHED_ID_EVENTDEV &&
+	       _odp_eventdev_gbl->crypto_adapter.enabled;
+}
+
+static int crypto_adapter_init(void)
+{
+	struct rte_event_port_conf port_conf;
+	const struct rte_event_dev_config *ev_config = &_odp_eventdev_gbl->config;
+	const uint8_t evdev_id = _odp_eventdev_gbl->dev_id;
+	int num_dummy_links = ev_config->nb_event_queues;
+	uint8_t dummy_links[num_dummy_links];
+	uint32_t service_id = 0;
+	int num_qpairs = 0;
+	int ret;
+
+	memset(&port_conf, 0, sizeof(struct rte_event_port_conf));
+	port_conf.new_event_threshold = ev_config->nb_events_limit;
+	port_conf.dequeue_depth = ev_config->nb_event_port_dequeue_depth;
+	port_conf.enqueue_depth = ev_config->nb_event_port_enqueue_depth;
+
+	ret = rte_event_crypto_adapter_create(CRYPTO_ADAPTER_ID, evdev_id, &port_conf,
+					      RTE_EVENT_CRYPTO_ADAPTER_OP_NEW);
+	if (ret) {
+		_ODP_ERR("rte_event_crypto_adapter_create failed: %d\n", ret);
+		return -1;
+	}
+
+	/* SW eventdev requires that all queues have ports linked */
+	num_dummy_links = _odp_dummy_link_queues(evdev_id, dummy_links, num_dummy_links);
+	if (num_dummy_links < 0)
+		goto fail;
+
+	for (int i = 0; i < global->num_devs; i++) {
+		cryptodev_t *dev = &global->devs[i];
+		uint32_t caps;
+
+		if (!dev->adapter)
+			continue;
+
+		if (rte_event_crypto_adapter_caps_get(evdev_id, dev->dev_id, &caps)) {
+			_ODP_ERR("rte_event_crypto_adapter_caps_get failed\n");
+			dev->adapter = false;
+			continue;
+		}
+
+		/* Completion event parameters are stored per session */
+		if ((caps & RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_QP_EV_BIND) ||
+		    ((caps & RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_NEW) &&
+		     !(caps & RTE_EVENT_CRYPTO_ADAPTER_CAP_SESSION_PRIVATE_DATA))) {
+			_ODP_PRINT("Crypto adapter not supported by crypto device %" PRIu8 "\n",
+				   dev->dev_id);
+			dev->adapter = false;
+			continue;
+		}
+
+		ret = rte_event_crypto_adapter_queue_pair_add(CRYPTO_ADAPTER_ID, dev->dev_id,
+							      dev->num_qpairs, NULL);
+		if (ret) {
+			_ODP_ERR("rte_event_crypto_adapter_queue_pair_add failed: %d\n", ret);
+			dev->adapter = false;
+			continue;
+		}
+		num_qpairs++;
+	}
+
+	if (_odp_dummy_unlink_queues(evdev_id, dummy_links, num_dummy_links))
+		goto fail;
+
+	if (num_qpairs == 0) {
+		_ODP_PRINT("No crypto devices available for crypto adapter\n");
+		(void)rte_event_crypto_adapter_free(CRYPTO_ADAPTER_ID);
+		return 0;
+	}
+
+	ret = rte_event_crypto_adapter_service_id_get(CRYPTO_ADAPTER_ID, &service_id);
+	if (ret && ret != -ESRCH) {
+		_ODP_ERR("Unable to retrieve crypto adapter service ID\n");
+		goto fail;
+	} else if (!ret && _odp_service_setup(service_id)) {
+		_ODP_ERR("Unable to setup crypto adapter service\n");
+		goto fail;
+	}
+
+	if (rte_event_crypto_adapter_start(CRYPTO_ADAPTER_ID)) {
+		_ODP_ERR("rte_event_crypto_adapter_start failed\n");
+		goto fail;
+	}
+
+	global->adapter_running = true;
+	return 0;
+
+fail:
+	for (int i = 0; i < global->num_devs; i++) {
+		cryptodev_t *dev = &global->devs[i];
+
+		if (dev->adapter)
+			(void)rte_event_crypto_adapter_queue_pair_del(CRYPTO_ADAPTER_ID,
+								      dev->dev_id,
+								      dev->num_qpairs);
+		dev->adapter = false;
+	}
+	(void)rte_event_crypto_adapter_free(CRYPTO_ADAPTER_ID);
+	return -1;
+}
+
+static int crypto_adapter_term(void)
+{
+	int ret = 0;
+
+	if (!global->adapter_running)
+		return 0;
+
+	if (rte_event_crypto_adapter_stop(CRYPTO_ADAPTER_ID)) {
+		_ODP_ERR("rte_event_crypto_adapter_stop failed\n");
+		ret = -1;
+	}
+
+	for (int i = 0; i < global->num_devs; i++) {
+		cryptodev_t *dev = &global->devs[i];
+
+		if (dev->adapter &&
+		    rte_event_crypto_adapter_queue_pair_del(CRYPTO_ADAPTER_ID, dev->dev_id,
+							    dev->num_qpairs)) {
+			_ODP_ERR("rte_event_crypto_adapter_queue_pair_del failed\n");
+			ret = -1;
+		}
+		dev->adapter = false;
+	}
+
+	if (rte_event_crypto_adapter_free(CRYPTO_ADAPTER_ID)) {
+		_ODP_ERR("rte_event_crypto_adapter_free failed\n");
+		ret = -1;
+	}
+
+	global->adapter_running = false;
+	return ret;
+}
+
 int _odp_crypto_init_global(void)
 {
 	crypto_config_t config;
@@ -383,7 +569,12 @@ int _odp_crypto_init_global(void)
 	int rc = -1;
 	unsigned int pool_size;
 	unsigned int nb_queue_pairs = 0, queue_pair;
+	unsigned int total_queue_pairs = 0;
+	unsigned int num_adapter_qpairs = 0;
+	odp_bool_t use_adapter;
 	uint32_t max_sess_sz = 0, sess_sz;
+	size_t qpair_offset;
+	crypto_qpair_t *qpair;
 	odp_shm_t shm;
 
 	if (read_config(&config))
@@ -400,9 +591,17 @@ int _odp_crypto_init_global(void)
 		return 0;
 	}
 
+	if (cdev_count > MAX_CRYPTODEVS) {
+		_ODP_ERR("Too many crypto devices, skipping the rest\n");
+		cdev_count = MAX_CRYPTODEVS;
+	}
+
 	/* Calculate the memory size we need */
 	mem_size  = sizeof(*global);
 	mem_size += (config.max_sessions * sizeof(crypto_session_entry_t));
+	qpair_offset = _ODP_ROUNDUP_CACHE_LINE(mem_size);
+	/* One additional queue pair per device may be reserved for crypto adapter */
+	mem_size = qpair_offset + cdev_count * (odp_thread_count_max() + 1) * sizeof(crypto_qpair_t);
 
 	/* Allocate our globally shared memory */
 	shm = odp_shm_reserve("_odp_crypto_global", mem_size,
@@ -430,6 +629,8 @@ int _odp_crypto_init_global(void)
 
 	global->num_devs = 0;
 	odp_spinlock_init(&global->lock);
+	use_adapter = crypto_adapter_requested();
+	qpair = (crypto_qpair_t *)(uintptr_t)((uint8_t *)global + qpair_offset);
 
 	for (cdev_id = 0; cdev_id < cdev_count; cdev_id++) {
 		sess_sz = rte_cryptodev_sym_get_private_session_size(cdev_id);
@@ -442,6 +643,7 @@ int _odp_crypto_init_global(void)
 		struct rte_cryptodev_info dev_info;
 		struct rte_mempool *mp;
 		odp_bool_t queue_pairs_shared = false;
+		odp_bool_t adapter_qpair = false;
 
 		rte_cryptodev_info_get(cdev_id, &dev_info);
 		nb_queue_pairs = odp_thread_count_max();
@@ -460,11 +662,15 @@ int _odp_crypto_init_global(void)
 				  cdev_id, dev_info.driver_name);
 		}
 
+		/* Crypto adapter dequeues from a dedicated queue pair */
+		if (use_adapter && nb_queue_pairs < dev_info.max_nb_queue_pairs)
+			adapter_qpair = true;
+
 		struct rte_cryptodev_qp_conf qp_conf;
 		uint8_t socket_id = rte_cryptodev_socket_id(cdev_id);
 
 		struct rte_cryptodev_config conf = {
-			.nb_queue_pairs = nb_queue_pairs,
+			.nb_queue_pairs = nb_queue_pairs + adapter_qpair,
 			.socket_id = socket_id,
 		};
 
@@ -519,7 +725,8 @@ int _odp_crypto_init_global(void)
 			goto fail;
 		}
 
-		qp_conf.nb_descriptors = NB_DESC_PER_QUEUE_PAIR;
+		qp_conf.nb_descriptors = config.async_enq ? NB_DESC_PER_QUEUE_PAIR_ASYNC :
+							    NB_DESC_PER_QUEUE_PAIR;
 
 		for (queue_pair = 0; queue_pair < nb_queue_pairs;
 							queue_pair++) {
@@ -535,20 +742,37 @@ int _odp_crypto_init_global(void)
 			}
 		}
 
+		if (adapter_qpair) {
+			qp_conf.nb_descriptors = NB_DESC_PER_QUEUE_PAIR_ASYNC;
+			rc = rte_cryptodev_queue_pair_setup(cdev_id, nb_queue_pairs,
+							    &qp_conf, socket_id);
+			if (rc < 0) {
+				_ODP_ERR("Fail to setup crypto adapter queue pair on dev %u",
+					 cdev_id);
+				goto fail;
+			}
+		}
+
 		rc = rte_cryptodev_start(cdev_id);
 		if (rc < 0) {
 			_ODP_ERR("Failed to start device %u: error %d\n", cdev_id, rc);
 			goto fail;
 		}
 
+		for (queue_pair = 0; queue_pair < nb_queue_pairs + adapter_qpair; queue_pair++) {
+			odp_spinlock_init(&qpair[queue_pair].lock);
+			odp_atomic_init_u32(&qpair[queue_pair].num_async, 0);
+		}
+
 		global->devs[global->num_devs].dev_id = cdev_id;
 		global->devs[global->num_devs].qpairs_shared = queue_pairs_shared;
 		global->devs[global->num_devs].num_qpairs = nb_queue_pairs;
+		global->devs[global->num_devs].adapter = adapter_qpair;
+		global->devs[global->num_devs].qpair = qpair;
 		global->num_devs++;
-		if (global->num_devs >= MAX_CRYPTODEVS) {
-			_ODP_ERR("Too many crypto devices, skipping the rest\n");
-			break;
-		}
+		qpair += nb_queue_pairs + adapter_qpair;
+		total_queue_pairs += nb_queue_pairs;
+		num_adapter_qpairs += adapter_qpair;
 	}
 
 	/*
@@ -558,6 +782,15 @@ int _odp_crypto_init_global(void)
 	 */
 	pool_size = 2 * odp_thread_count_max() * OP_CACHE_SIZE;
 
+	/* Asynchronous operations may fill all queue pair descriptors */
+	if (config.async_enq)
+		pool_size += total_queue_pairs * NB_DESC_PER_QUEUE_PAIR_ASYNC;
+
+	/* Crypto adapter completions may be held in queue pairs and in the event device */
+	if (num_adapter_qpairs)
+		pool_size += num_adapter_qpairs * NB_DESC_PER_QUEUE_PAIR_ASYNC +
+			     _odp_eventdev_gbl->config.nb_events_limit;
+
 	/* create crypto op pool */
 	global->crypto_op_pool =
 		rte_crypto_op_pool_create("crypto_op_pool",
@@ -573,6 +806,14 @@ int _odp_crypto_init_global(void)
 		goto fail;
 	}
 
+	if (config.async_enq && global->num_devs)
+		odp_global_rw->crypto_compl_poll = true;
+
+	if (num_adapter_qpairs && crypto_adapter_init()) {
+		_ODP_ERR("Crypto adapter init failed\n");
+		goto fail;
+	}
+
 	return 0;
 
 fail:
@@ -585,8 +826,14 @@ int _odp_crypto_init_local(void)
 	return 0;
 }
 
+static void crypto_drain_qpairs(uint32_t first_qp, uint32_t num_qp);
+
 int _odp_crypto_term_local(void)
 {
+	/* Complete asynchronous operations left in the queue pairs of this thread */
+	if (global && global->config.async_enq)
+		crypto_drain_qpairs(odp_thread_id(), 1);
+
 	return 0;
 }
 
@@ -1323,6 +1570,36 @@ get_crypto_dev(struct rte_crypto_sym_xform *cipher_xform,
 				 : ODP_CRYPTO_SES_ERR_AUTH;
 }
 
+/* Find a crypto device that implements null cipher and null auth algorithms */
+static int get_crypto_null_dev(cryptodev_t **device)
+{
+	struct rte_crypto_sym_xform cipher_xform = {
+		.type = RTE_CRYPTO_SYM_XFORM_CIPHER,
+		.cipher.algo = RTE_CRYPTO_CIPHER_NULL
+	};
+	struct rte_crypto_sym_xform auth_xform = {
+		.type = RTE_CRYPTO_SYM_XFORM_AUTH,
+		.auth.algo = RTE_CRYPTO_AUTH_NULL
+	};
+
+	for (int n = 0; n < global->num_devs; n++) {
+		cryptodev_t *dev = &global->devs[n];
+		struct rte_cryptodev_info dev_info;
+
+		if (!dev->adapter)
+			continue;
+
+		rte_cryptodev_info_get(dev->dev_id, &dev_info);
+
+		if (find_capa_for_alg(&dev_info, &cipher_xform) &&
+		    find_capa_for_alg(&dev_info, &auth_xform)) {
+			*device = dev;
+			return 0;
+		}
+	}
+	return -1;
+}
+
 static int chained_bufs_ok(const odp_crypto_session_param_t *param,
 			   uint8_t cdev_id)
 {
@@ -1449,6 +1726,56 @@ static int crypto_fill_aead_xform(struct rte_crypto_sym_xform *aead_xform,
 	return 0;
 }
 
+/*
+ * Completions of asynchronously enqueued operations are polled by the
+ * scheduler and delivered outside of the scheduling context of the enqueuing
+ * thread. Use asynchronous enqueue only when the completion queue is a
+ * scheduled queue that does not require ordering.
+ */
+static odp_bool_t use_async_enq(const odp_crypto_session_param_t *param)
+{
+	odp_queue_info_t info;
+
+	if (!global->config.async_enq || param->op_mode != ODP_CRYPTO_ASYNC)
+		return false;
+
+	if (odp_queue_info(param->compl_queue, &info))
+		return false;
+
+	return info.param.type == ODP_QUEUE_TYPE_SCHED &&
+	       info.param.order == ODP_QUEUE_ORDER_IGNORE;
+}
+
+/*
+ * Completion events of crypto adapter sessions are injected to the completion
+ * queue by the event device.
+ */
+static odp_bool_t use_crypto_adapter(const odp_crypto_session_param_t *param)
+{
+	return global->adapter_running && param->op_mode == ODP_CRYPTO_ASYNC &&
+	       odp_queue_type(param->compl_queue) == ODP_QUEUE_TYPE_SCHED;
+}
+
+static int crypto_adapter_session_init(const cryptodev_t *dev,
+				       struct rte_cryptodev_sym_session *rte_session,
+				       odp_queue_t compl_queue)
+{
+	queue_entry_t *queue = qentry_from_handle(compl_queue);
+	union rte_event_crypto_metadata m_data;
+
+	memset(&m_data, 0, sizeof(m_data));
+	m_data.response_info.queue_id = queue->index;
+	m_data.response_info.sched_type = event_schedule_type(queue->param.sched.sync);
+	m_data.response_info.priority = queue->eventdev.prio;
+	m_data.response_info.event_type = RTE_EVENT_TYPE_CRYPTODEV;
+	m_data.response_info.op = RTE_EVENT_OP_NEW;
+
+	return rte_cryptodev_session_event_mdata_set(dev->dev_id, rte_session,
+						     RTE_CRYPTO_OP_TYPE_SYMMETRIC,
+						     RTE_CRYPTO_OP_WITH_SESSION,
+						     &m_data, sizeof(m_data));
+}
+
 int odp_crypto_session_create(const odp_crypto_session_param_t *param,
 			      odp_crypto_session_t *session_out,
 			      odp_crypto_ses_create_err_t *status)
@@ -1522,6 +1849,7 @@ int odp_crypto_session_create(const odp_crypto_session_param_t *param,
 		rc = get_crypto_aead_dev(&cipher_xform, &dev);
 	} else {
 		odp_bool_t do_cipher_first;
+		odp_bool_t null_dev = false;
 
 		session->flags.aead = 0;
 
@@ -1544,10 +1872,18 @@ int odp_crypto_session_create(const odp_crypto_session_param_t *param,
 		/* Derive order */
 		if (param->cipher_alg == ODP_CIPHER_ALG_NULL &&
 		    param->auth_alg == ODP_AUTH_ALG_NULL) {
-			rte_session = NULL;
-			cdev_id = ~0;
-			session->flags.chained_bufs_ok = 1;
-			goto out_null;
+			/* Null operations of crypto adapter sessions are passed
+			 * through a crypto device, so that their completions are
+			 * delivered by the crypto adapter as well. */
+			if (!use_crypto_adapter(param) || get_crypto_null_dev(&dev)) {
+				rte_session = NULL;
+				cdev_id = ~0;
+				session->flags.chained_bufs_ok = 1;
+				goto out_null;
+			}
+			first_xform = &cipher_xform;
+			first_xform->next = &auth_xform;
+			null_dev = true;
 		} else if (param->cipher_alg == ODP_CIPHER_ALG_NULL) {
 			first_xform = &auth_xform;
 		} else if (param->auth_alg == ODP_AUTH_ALG_NULL) {
@@ -1560,7 +1896,8 @@ int odp_crypto_session_create(const odp_crypto_session_param_t *param,
 			first_xform->next = &cipher_xform;
 		}
 
-		rc = get_crypto_dev(&cipher_xform, &auth_xform, &dev);
+		if (!null_dev)
+			rc = get_crypto_dev(&cipher_xform, &auth_xform, &dev);
 	}
 	if (rc != ODP_CRYPTO_SES_ERR_NONE) {
 		_ODP_DBG("Couldn't find a crypto device (error %d)", rc);
@@ -1580,9 +1917,20 @@ int odp_crypto_session_create(const odp_crypto_session_param_t *param,
 	}
 
 	session->flags.chained_bufs_ok = chained_bufs_ok(param, cdev_id);
-	session->flags.cdev_qpairs_shared = dev->qpairs_shared;
+	session->flags.async = use_async_enq(param);
 	session->dev = dev;
 
+	if (dev->adapter && use_crypto_adapter(param)) {
+		if (crypto_adapter_session_init(dev, rte_session, param->compl_queue)) {
+			_ODP_ERR("Crypto adapter session init failed\n");
+			rte_cryptodev_sym_session_free(cdev_id, rte_session);
+			*status = ODP_CRYPTO_SES_ERR_ENOMEM;
+			goto err;
+		}
+		session->flags.async = 1;
+		session->flags.adapter = 1;
+	}
+
 out_null:
 	session->rte_session  = rte_session;
 	session->cdev_id = cdev_id;
@@ -1634,6 +1982,14 @@ int _odp_crypto_term_global(void)
 	if (global == NULL)
 		return 0;
 
+	if (crypto_adapter_term())
+		rc = -1;
+
+	if (global->config.async_enq) {
+		crypto_drain_qpairs(0, odp_thread_count_max());
+		odp_global_rw->crypto_compl_poll = false;
+	}
+
 	for (session = global->free; session != NULL; session = session->next)
 		count++;
 	if (count != global->config.max_sessions) {
@@ -1994,22 +2350,53 @@ static void op_prepare(crypto_op_t *ops[],
 	}
 }
 
-static void dev_enq_deq(uint8_t cdev_id, int thread_id, crypto_op_t *op[], int num_op)
+static inline uint16_t qpair_index(const cryptodev_t *dev, int thread_id)
+{
+	if (odp_unlikely(dev->qpairs_shared))
+		return thread_id % dev->num_qpairs;
+
+	return thread_id;
+}
+
+/*
+ * Move completed asynchronous operations from a dequeued burst to 'async_op'
+ * table. Return the number of remaining (synchronous) operations.
+ */
+static int split_async_ops(crypto_qpair_t *qp, crypto_op_t *op[], int num,
+			   crypto_op_t *async_op[], int *num_async)
+{
+	int num_sync = 0;
+
+	for (int n = 0; n < num; n++) {
+		if (op[n]->state.status == S_DEV_ASYNC)
+			async_op[(*num_async)++] = op[n];
+		else
+			op[num_sync++] = op[n];
+	}
+
+	if (num_sync < num)
+		odp_atomic_sub_u32(&qp->num_async, num - num_sync);
+
+	return num_sync;
+}
+
+static void async_op_complete(crypto_op_t *op[], int num);
+
+static void dev_enq_deq(const cryptodev_t *dev, int thread_id, crypto_op_t *op[], int num_op)
 {
 	int retry_count = 0;
 	int rc;
-	int queue_pairs_shared;
-	int queue_pair;
-	struct rte_crypto_op *deq_op[MAX_BURST];
-
-	queue_pairs_shared = op[0]->state.session->flags.cdev_qpairs_shared;
-	if (odp_unlikely(queue_pairs_shared))
-		queue_pair = thread_id % op[0]->state.session->dev->num_qpairs;
-	else
-		queue_pair = thread_id;
+	const uint8_t cdev_id = dev->dev_id;
+	const uint16_t queue_pair = qpair_index(dev, thread_id);
+	crypto_qpair_t *qp = &dev->qpair[queue_pair];
+	/* Other threads may access the queue pair if it is shared or async enqueue is used */
+	const int use_lock = dev->qpairs_shared || global->config.async_enq;
+	crypto_op_t *deq_op[MAX_BURST];
+	crypto_op_t *async_op[NB_DESC_PER_QUEUE_PAIR_ASYNC];
+	int num_async = 0;
 
 	/*
-	 * If queue pairs are shared between multiple threads,
+	 * If the queue pair may be accessed by multiple threads,
 	 * we protect enqueue and dequeue using a lock. In addition,
 	 * we keep the lock over the whole enqueue-dequeue sequence
 	 * to guarantee that we get the same op back as what we
@@ -2018,14 +2405,14 @@ static void dev_enq_deq(uint8_t cdev_id, int thread_id, crypto_op_t *op[], int n
 	 * operation that was sent to the same queue pair from
 	 * another thread.
 	 */
-	if (odp_unlikely(queue_pairs_shared))
-		odp_spinlock_lock(&global->lock);
+	if (odp_unlikely(use_lock))
+		odp_spinlock_lock(&qp->lock);
 
 	rc = rte_cryptodev_enqueue_burst(cdev_id, queue_pair,
 					 (struct rte_crypto_op **)op, num_op);
 	if (odp_unlikely(rc < num_op)) {
-		if (odp_unlikely(queue_pairs_shared))
-			odp_spinlock_unlock(&global->lock);
+		if (odp_unlikely(use_lock))
+			odp_spinlock_unlock(&qp->lock);
 		/*
 		 * This should not happen since we allocated enough
 		 * descriptors for our max burst and there are no other ops
@@ -2037,6 +2424,8 @@ static void dev_enq_deq(uint8_t cdev_id, int thread_id, crypto_op_t *op[], int n
 		num_op = rc;
 		if (num_op == 0)
 			return;
+		if (odp_unlikely(use_lock))
+			odp_spinlock_lock(&qp->lock);
 	}
 
 	/* There may be a delay until the crypto operation is completed. */
@@ -2046,8 +2435,13 @@ static void dev_enq_deq(uint8_t cdev_id, int thread_id, crypto_op_t *op[], int n
 		int num_left = num_op - num_dequeued;
 
 		rc = rte_cryptodev_dequeue_burst(cdev_id, queue_pair,
-						 &deq_op[num_dequeued],
+						 (struct rte_crypto_op **)&deq_op[num_dequeued],
 						 num_left);
+
+		/* Asynchronous operations enqueued earlier to the same queue pair */
+		if (odp_unlikely(rc && odp_atomic_load_u32(&qp->num_async)))
+			rc = split_async_ops(qp, &deq_op[num_dequeued], rc, async_op, &num_async);
+
 		num_dequeued += rc;
 		if (odp_likely(rc == num_left))
 			break;
@@ -2064,52 +2458,160 @@ static void dev_enq_deq(uint8_t cdev_id, int thread_id, crypto_op_t *op[], int n
 		}
 	};
 
-	if (odp_unlikely(queue_pairs_shared))
-		odp_spinlock_unlock(&global->lock);
+	if (odp_unlikely(use_lock))
+		odp_spinlock_unlock(&qp->lock);
+
+	if (odp_unlikely(num_async))
+		async_op_complete(async_op, num_async);
 
 	for (int n = 0; n < num_dequeued; n++) {
-		_ODP_ASSERT((crypto_op_t *)deq_op[n] == op[n]);
-		_ODP_ASSERT((odp_packet_t)deq_op[n]->sym->m_src == op[n]->state.pkt);
+		_ODP_ASSERT(deq_op[n] == op[n]);
+		_ODP_ASSERT((odp_packet_t)deq_op[n]->op.sym->m_src == op[n]->state.pkt);
+	}
+}
+
+/* Dequeue completed asynchronous operations. Queue pair lock must be held. */
+static inline int qpair_dequeue(const cryptodev_t *dev, uint16_t queue_pair,
+				crypto_op_t *op[], int max_num)
+{
+	int num = rte_cryptodev_dequeue_burst(dev->dev_id, queue_pair,
+					      (struct rte_crypto_op **)op, max_num);
+
+	if (num)
+		odp_atomic_sub_u32(&dev->qpair[queue_pair].num_async, num);
+
+	return num;
+}
+
+/*
+ * Enqueue operations to a crypto device without waiting for completion.
+ * Completions are delivered to completion queues by _odp_crypto_compl_poll().
+ * Caller may not access the operations after this call.
+ */
+static void dev_enq_async(const cryptodev_t *dev, int thread_id, crypto_op_t *op[], int num_op)
+{
+	const uint16_t queue_pair = qpair_index(dev, thread_id);
+	crypto_qpair_t *qp = &dev->qpair[queue_pair];
+	crypto_op_t *deq_op[MAX_BURST];
+	int retry_count = 0;
+	int num_enq = 0;
+	int num_deq;
+	int rc;
+
+	while (1) {
+		num_deq = 0;
+
+		odp_spinlock_lock(&qp->lock);
+
+		rc = rte_cryptodev_enqueue_burst(dev->dev_id, queue_pair,
+						 (struct rte_crypto_op **)&op[num_enq],
+						 num_op - num_enq);
+		odp_atomic_add_u32(&qp->num_async, rc);
+		num_enq += rc;
+
+		/* Queue pair is full, make room by completing earlier operations */
+		if (odp_unlikely(num_enq < num_op))
+			num_deq = qpair_dequeue(dev, queue_pair, deq_op, MAX_BURST);
+
+		odp_spinlock_unlock(&qp->lock);
+
+		if (odp_likely(num_enq == num_op))
+			break;
+
+		if (num_deq) {
+			async_op_complete(deq_op, num_deq);
+			continue;
+		}
+
+		odp_time_wait_ns(DEQ_RETRY_DELAY_NS);
+		if (++retry_count == MAX_DEQ_RETRIES)
+			_ODP_ERR("Failed to enqueue crypto operations\n");
+	}
+}
+
+/*
+ * Enqueue operations to the queue pair serviced by crypto adapter. Completion
+ * events are injected to completion queues by the event device.
+ */
+static void dev_enq_adapter(const cryptodev_t *dev, crypto_op_t *op[], int num_op)
+{
+	const uint16_t queue_pair = dev->num_qpairs;
+	crypto_qpair_t *qp = &dev->qpair[queue_pair];
+	int retry_count = 0;
+	int num_enq = 0;
+
+	while (1) {
+		odp_spinlock_lock(&qp->lock);
+		num_enq += rte_cryptodev_enqueue_burst(dev->dev_id, queue_pair,
+						       (struct rte_crypto_op **)&op[num_enq],
+						       num_op - num_enq);
+		odp_spinlock_unlock(&qp->lock);
+
+		if (odp_likely(num_enq == num_op))
+			break;
+
+		/* Queue pair is full, wait for crypto adapter to dequeue */
+		odp_time_wait_ns(DEQ_RETRY_DELAY_NS);
+		if (++retry_count == MAX_DEQ_RETRIES)
+			_ODP_ERR("Failed to enqueue crypto operations\n");
 	}
 }
 
+/*
+ * Send operations to crypto devices. Operations enqueued asynchronously are
+ * removed from the op table (set to NULL), others have been completed when
+ * this function returns.
+ */
 static void op_enq_deq(crypto_op_t *op[], int num_op)
 {
 	crypto_op_t *burst[MAX_BURST];
 	int burst_size = 0;
-	int idx = 0;
 	uint8_t cdev_id;
+	unsigned int async, adapter;
 	int tid = odp_thread_id();
-	int done = 0;
 
-	while (done < num_op) {
-		if (op[idx]->state.status != S_OK) {
-			idx++;
-			done++;
+	for (int idx = 0; idx < num_op; idx++) {
+		if (op[idx] == NULL || op[idx]->state.status != S_OK)
 			continue;
-		}
+
 		burst[0] = op[idx];
 		burst_size = 1;
 		cdev_id = op[idx]->state.session->cdev_id;
-		op[idx]->state.status = S_DEV;
-		idx++;
+		async = op[idx]->state.session->flags.async;
+		adapter = op[idx]->state.session->flags.adapter;
+		op[idx]->state.status = async ? S_DEV_ASYNC : S_DEV;
 
 		/*
-		 * Build a burst of ops that are for the same device
-		 * and have not failed already and are not no-ops.
+		 * Build a burst of ops that are for the same device, use the same
+		 * enqueue mode and have not failed already and are not no-ops.
 		 */
-		for (int n = idx; n < num_op; n++) {
-			if (odp_likely(op[n]->state.session->cdev_id == cdev_id) &&
+		for (int n = idx + 1; n < num_op; n++) {
+			if (odp_likely(op[n] != NULL) &&
+			    odp_likely(op[n]->state.session->cdev_id == cdev_id) &&
+			    odp_likely(op[n]->state.session->flags.async == async) &&
+			    odp_likely(op[n]->state.session->flags.adapter == adapter) &&
 			    odp_likely(op[n]->state.status == S_OK)) {
 				burst[burst_size++] = op[n];
-				op[n]->state.status = S_DEV;
+				op[n]->state.status = async ? S_DEV_ASYNC : S_DEV;
 			}
 		}
+
 		/*
 		 * Process burst.
 		 */
-		dev_enq_deq(cdev_id, tid, burst, burst_size);
-		done += burst_size;
+		if (async) {
+			/* Operations may complete in another thread after enqueue */
+			for (int n = idx; n < num_op; n++) {
+				if (op[n] != NULL && op[n]->state.status == S_DEV_ASYNC)
+					op[n] = NULL;
+			}
+			if (adapter)
+				dev_enq_adapter(burst[0]->state.session->dev, burst, burst_size);
+			else
+				dev_enq_async(burst[0]->state.session->dev, tid, burst, burst_size);
+		} else {
+			dev_enq_deq(burst[0]->state.session->dev, tid, burst, burst_size);
+		}
 	}
 }
 
@@ -2122,7 +2624,7 @@ static void op_finish(crypto_op_t *op)
 	odp_crypto_alg_err_t rc_auth;
 	odp_crypto_packet_result_t *op_result;
 
-	if (odp_likely(op->state.status == S_DEV)) {
+	if (odp_likely(op->state.status == S_DEV || op->state.status == S_DEV_ASYNC)) {
 		/* cryptodev processed packet */
 		if (odp_likely(rte_op->status == RTE_CRYPTO_OP_STATUS_SUCCESS)) {
 			rc_cipher = ODP_CRYPTO_ALG_ERR_NONE;
@@ -2170,6 +2672,126 @@ static void op_finish(crypto_op_t *op)
 	op_result->auth_status.alg_err = rc_auth;
 }
 
+/* Finish asynchronous operations and enqueue packets to completion queues */
+static void async_op_complete(crypto_op_t *op[], int num)
+{
+	odp_event_t event[MAX_BURST];
+	odp_queue_t queue = ODP_QUEUE_INVALID;
+	int num_ev = 0;
+
+	for (int n = 0; n <= num; n++) {
+		odp_queue_t compl_queue = ODP_QUEUE_INVALID;
+		int ret;
+
+		if (n < num)
+			compl_queue = op[n]->state.session->p.compl_queue;
+
+		/* Enqueue events of consecutive operations with the same completion queue */
+		if (num_ev && (compl_queue != queue || num_ev == MAX_BURST || n == num)) {
+			ret = odp_queue_enq_multi(queue, event, num_ev);
+			if (odp_unlikely(ret < num_ev)) {
+				if (ret < 0)
+					ret = 0;
+				_ODP_ERR("Failed to enqueue crypto completion events\n");
+				odp_event_free_multi(&event[ret], num_ev - ret);
+			}
+			num_ev = 0;
+		}
+
+		if (n == num)
+			break;
+
+		op_finish(op[n]);
+		queue = compl_queue;
+		event[num_ev++] = odp_packet_to_event(op[n]->state.pkt);
+		rte_crypto_op_free((struct rte_crypto_op *)op[n]);
+	}
+}
+
+odp_event_t _odp_crypto_adapter_event(void *crypto_op)
+{
+	crypto_op_t *op = crypto_op;
+	odp_packet_t pkt;
+
+	op_finish(op);
+	pkt = op->state.pkt;
+	rte_crypto_op_free((struct rte_crypto_op *)op);
+
+	return odp_packet_to_event(pkt);
+}
+
+/* Complete asynchronous operations of a queue pair, if the queue pair is not busy */
+static int qpair_poll(const cryptodev_t *dev, uint16_t queue_pair)
+{
+	crypto_qpair_t *qp = &dev->qpair[queue_pair];
+	crypto_op_t *op[MAX_BURST];
+	int num;
+
+	if (odp_atomic_load_u32(&qp->num_async) == 0)
+		return 0;
+
+	if (!odp_spinlock_trylock(&qp->lock))
+		return 0;
+
+	num = qpair_dequeue(dev, queue_pair, op, MAX_BURST);
+
+	odp_spinlock_unlock(&qp->lock);
+
+	if (num)
+		async_op_complete(op, num);
+
+	return num;
+}
+
+int _odp_crypto_compl_poll(void)
+{
+	const int tid = odp_thread_id();
+	int num = 0;
+
+	for (int i = 0; i < global->num_devs; i++) {
+		const cryptodev_t *dev = &global->devs[i];
+
+		num += qpair_poll(dev, qpair_index(dev, tid));
+
+		/* Help with queue pairs of threads that are not currently scheduling */
+		num += qpair_poll(dev, poll_idx % dev->num_qpairs);
+	}
+	poll_idx++;
+
+	return num;
+}
+
+static void qpair_drain(const cryptodev_t *dev, uint16_t queue_pair)
+{
+	int retry_count = 0;
+
+	while (odp_atomic_load_u32(&dev->qpair[queue_pair].num_async)) {
+		if (qpair_poll(dev, queue_pair))
+			continue;
+
+		odp_time_wait_ns(DEQ_RETRY_DELAY_NS);
+		if (++retry_count == MAX_DEQ_RETRIES) {
+			_ODP_ERR("Failed to dequeue crypto operations\n");
+			return;
+		}
+	}
+}
+
+static void crypto_drain_qpairs(uint32_t first_qp, uint32_t num_qp)
+{
+	for (int i = 0; i < global->num_devs; i++) {
+		const cryptodev_t *dev = &global->devs[i];
+
+		if (num_qp == 1) {
+			qpair_drain(dev, qpair_index(dev, first_qp));
+			continue;
+		}
+
+		for (uint32_t qp = first_qp; qp < first_qp + num_qp && qp < dev->num_qpairs; qp++)
+			qpair_drain(dev, qp);
+	}
+}
+
 static
 int odp_crypto_int(const odp_packet_t pkt_in[],
 		   odp_packet_t pkt_out[],
@@ -2187,6 +2809,12 @@ int odp_crypto_int(const odp_packet_t pkt_in[],
 	op_enq_deq(op, num_pkt);
 
 	for (int n = 0; n < num_pkt; n++) {
+		/* Asynchronously enqueued, completion event is delivered later */
+		if (op[n] == NULL) {
+			pkt_out[n] = ODP_PACKET_INVALID;
+			continue;
+		}
+
 		op_finish(op[n]);
 		pkt_out[n] = op[n]->state.pkt;
 		rte_crypto_op_free((struct rte_crypto_op *)op[n]);
@@ -2239,6 +2867,9 @@ int odp_crypto_op_enq(const odp_packet_t pkt_in[],
 	num_pkt = odp_crypto_int(pkt_in, out_pkts, param, num_pkt);
 
 	for (i = 0; i < num_pkt; i++) {
+		if (out_pkts[i] == ODP_PACKET_INVALID)
+			continue;
+
 		session = (crypto_session_entry_t *)(intptr_t)param[i].session;
 		event = odp_packet_to_event(out_pkts[i]);
 		if (odp_queue_enq(session->p.compl_queue, event)) {
@@ -8,6 +8,7 @@
 #include <odp/api/plat/strong_types.h>
 
 #include <odp_debug_internal.h>
+#include <odp_dma_internal.h>
 #include <odp_init_internal.h>
 
 #include <odp/api/align.h>
@@ -39,10 +40,13 @@
 #define CONF_BASE_STR "dma"
 #define CONF_SEG_LEN "max_seg_len"
 #define CONF_INFLIGHT "max_inflight"
+#define CONF_PKT_COPY "packet_copy"
+#define CONF_PKT_COPY_MIN_LEN "packet_copy_min_len"
 #define MAX_SEG_LEN UINT16_MAX
 #define MAX_TRANSFERS 256U
 #define DEF_VCHAN 0U
 #define MAX_DEQ 32U
+#define PKT_COPY_NUM_DESC 128U
 #define LOCK_IF(cond, lock) \
 	do { \
 		if ((cond)) \
@@ -94,17 +98,28 @@ typedef struct ODP_ALIGNED_CACHE {
 	char name[ODP_DMA_NAME_LEN];
 } dma_session_t;
 
+typedef struct ODP_ALIGNED_CACHE {
+	odp_ticketlock_t lock;
+	uint32_t min_len;
+	int16_t dev_id;
+	uint8_t is_active;
+} pkt_copy_t;
+
 typedef struct {
 	odp_shm_t shm;
 	/* Buffer pool capability and default parameters */
 	odp_pool_capability_t pool_capa;
 	odp_pool_param_t pool_param;
 	dev_info_t dev_info;
+	/* Device reserved for packet copy offload */
+	pkt_copy_t pkt_copy;
 	dma_session_t sessions[MAX_SESSIONS];
 } dma_global_t;
 
 static dma_global_t *_odp_dma_glb;
 
+uint32_t _odp_dma_pkt_copy_min_len;
+
 static odp_bool_t is_matching_capa(const struct rte_dma_info *first,
 				   const struct rte_dma_info *second)
 {
@@ -141,6 +156,32 @@ static odp_bool_t parse_options(dev_info_t *dev_info)
 	return true;
 }
 
+static odp_bool_t parse_pkt_copy_options(pkt_copy_t *pkt_copy, odp_bool_t *enable)
+{
+	int val;
+
+	if (!_odp_libconfig_lookup_ext_int(CONF_BASE_STR, NULL, CONF_PKT_COPY, &val)) {
+		_ODP_ERR("Unable to parse " CONF_PKT_COPY " configuration\n");
+		return false;
+	}
+
+	*enable = !!val;
+
+	if (!_odp_libconfig_lookup_ext_int(CONF_BASE_STR, NULL, CONF_PKT_COPY_MIN_LEN, &val)) {
+		_ODP_ERR("Unable to parse " CONF_PKT_COPY_MIN_LEN " configuration\n");
+		return false;
+	}
+
+	if (val <= 0) {
+		_ODP_ERR("Bad " CONF_PKT_COPY_MIN_LEN " value: %d\n", val);
+		return false;
+	}
+
+	pkt_copy->min_len = val;
+
+	return true;
+}
+
 static odp_bool_t get_dma_dev_info(dma_global_t *config)
 {
 	uint32_t num_devices = 0U, max_transfers;
@@ -195,6 +236,45 @@ static odp_bool_t get_dma_dev_info(dma_global_t *config)
 	return true;
 }
 
+static odp_bool_t configure_dma_dev(uint32_t dev_id, uint16_t num_desc);
+
+/* Reserve the last found DMA device for packet copy offload. The device is not
+ * available for DMA sessions. */
+static odp_bool_t pkt_copy_init(dma_global_t *config)
+{
+	pkt_copy_t *pkt_copy = &config->pkt_copy;
+	const struct rte_dma_info *dev = &config->dev_info.dev;
+	odp_bool_t enable = false;
+	uint16_t num_desc;
+
+	odp_ticketlock_init(&pkt_copy->lock);
+
+	if (!parse_pkt_copy_options(pkt_copy, &enable))
+		return false;
+
+	if (!enable)
+		return true;
+
+	if (config->dev_info.num_devices == 0U) {
+		_ODP_PRINT("DMA packet copy: no DMA devices found, offload disabled\n");
+		return true;
+	}
+
+	config->dev_info.num_devices--;
+	pkt_copy->dev_id = config->sessions[config->dev_info.num_devices].dev_id;
+	num_desc = _ODP_MAX(dev->min_desc, _ODP_MIN(dev->max_desc, PKT_COPY_NUM_DESC));
+
+	if (!configure_dma_dev(pkt_copy->dev_id, num_desc))
+		return false;
+
+	pkt_copy->is_active = 1U;
+	_odp_dma_pkt_copy_min_len = pkt_copy->min_len;
+	_ODP_PRINT("DMA packet copy: device %d, min_len %u\n", pkt_copy->dev_id,
+		   pkt_copy->min_len);
+
+	return true;
+}
+
 int _odp_dma_init_global(void)
 {
 	odp_shm_t shm;
@@ -235,6 +315,11 @@ int _odp_dma_init_global(void)
 		return -1;
 	}
 
+	if (!pkt_copy_init(_odp_dma_glb)) {
+		_ODP_ERR("DMA packet copy init failed\n");
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -246,6 +331,12 @@ int _odp_dma_term_global(void)
 	for (uint32_t i = 0U; i < _odp_dma_glb->dev_info.num_devices; ++i)
 		(void)rte_dma_close(_odp_dma_glb->sessions[i].dev_id);
 
+	if (_odp_dma_glb->pkt_copy.is_active) {
+		_odp_dma_pkt_copy_min_len = 0U;
+		(void)rte_dma_stop(_odp_dma_glb->pkt_copy.dev_id);
+		(void)rte_dma_close(_odp_dma_glb->pkt_copy.dev_id);
+	}
+
 	if (odp_shm_free(_odp_dma_glb->shm)) {
 		_ODP_ERR("SHM free failed\n");
 		return -1;
@@ -490,7 +581,7 @@ odp_dma_t odp_dma_create(const char *name, const odp_dma_param_t *param)
 		return ODP_DMA_INVALID;
 	}
 
-	for (int i = 0; i < MAX_SESSIONS; i++) {
+	for (uint32_t i = 0U; i < _odp_dma_glb->dev_info.num_devices; i++) {
 		temp = &_odp_dma_glb->sessions[i];
 
 		if (temp->is_active)
@@ -641,6 +732,97 @@ static inline void dequeue_trs(dma_session_t *session)
 		*latest_idx = done_idx;
 }
 
+static inline rte_iova_t pkt_seg_iova(odp_packet_seg_t seg, const void *addr)
+{
+	const struct rte_mbuf *mb = (const struct rte_mbuf *)(uintptr_t)seg;
+
+	return mb->buf_iova + ((uintptr_t)addr - (uintptr_t)mb->buf_addr);
+}
+
+/* Wait until 'num' submitted packet copies have completed */
+static int pkt_copy_wait(int16_t dev_id, uint16_t num)
+{
+	enum rte_dma_status_code status[MAX_DEQ];
+	uint16_t done = 0U, last_idx;
+	bool has_error = false;
+	int ret = 0;
+
+	while (done < num) {
+		if (odp_likely(!has_error)) {
+			done += rte_dma_completed(dev_id, DEF_VCHAN, num - done, &last_idx,
+						  &has_error);
+			continue;
+		}
+
+		/* Operations following a failed one have to be dequeued with status */
+		ret = -1;
+		done += rte_dma_completed_status(dev_id, DEF_VCHAN, _ODP_MIN(num - done, MAX_DEQ),
+						 &last_idx, status);
+	}
+
+	return has_error ? -1 : ret;
+}
+
+int _odp_dma_pkt_copy(odp_packet_t dst, uint32_t dst_offset, odp_packet_t src,
+		      uint32_t src_offset, uint32_t len)
+{
+	pkt_copy_t *pkt_copy = &_odp_dma_glb->pkt_copy;
+	const int16_t dev_id = pkt_copy->dev_id;
+	const uint32_t max_seg_len = _odp_dma_glb->dev_info.max_seg_len;
+	uint16_t num = 0U;
+	int ret = 0;
+
+	odp_ticketlock_lock(&pkt_copy->lock);
+
+	while (len > 0) {
+		odp_packet_seg_t dst_seg, src_seg;
+		uint32_t dst_seglen, src_seglen, cpylen;
+		void *dst_addr, *src_addr;
+		int idx;
+
+		dst_addr = odp_packet_offset(dst, dst_offset, &dst_seglen, &dst_seg);
+		src_addr = odp_packet_offset(src, src_offset, &src_seglen, &src_seg);
+		cpylen = _ODP_MIN(len, _ODP_MIN(dst_seglen, src_seglen));
+		cpylen = _ODP_MIN(cpylen, max_seg_len);
+
+		idx = rte_dma_copy(dev_id, DEF_VCHAN, pkt_seg_iova(src_seg, src_addr),
+				   pkt_seg_iova(dst_seg, dst_addr), cpylen, 0);
+
+		if (odp_unlikely(idx == -ENOSPC && num)) {
+			/* Descriptor ring full, complete outstanding copies and retry */
+			rte_dma_submit(dev_id, DEF_VCHAN);
+			ret = pkt_copy_wait(dev_id, num);
+			num = 0U;
+
+			if (ret)
+				break;
+
+			continue;
+		}
+
+		if (odp_unlikely(idx < 0)) {
+			ret = -1;
+			break;
+		}
+
+		num++;
+		dst_offset += cpylen;
+		src_offset += cpylen;
+		len -= cpylen;
+	}
+
+	if (num) {
+		rte_dma_submit(dev_id, DEF_VCHAN);
+
+		if (pkt_copy_wait(dev_id, num))
+			ret = -1;
+	}
+
+	odp_ticketlock_unlock(&pkt_copy->lock);
+
+	return ret;
+}
+
 static inline transfer_t *trs_from_id(odp_dma_transfer_id_t id)
 {
 	return (transfer_t *)(uintptr_t)id;
@@ -22,6 +22,7 @@
 
 #include <odp_chksum_internal.h>
 #include <odp_debug_internal.h>
+#include <odp_dma_internal.h>
 #include <odp_event_internal.h>
 #include <odp_event_validation_internal.h>
 #include <odp_macros_internal.h>
@@ -106,6 +107,9 @@ ODP_STATIC_ASSERT(ODP_TIMEOUT_INVALID == 0, "Timeout invalid not 0");
 #pragma GCC diagnostic pop
 #endif
 
+/* Maximum number of bytes copied into the head segment of a new packet reference */
+#define PKT_REF_COPY_LEN 128
+
 /* Calculate the number of segments */
 static inline int num_segments(uint32_t len, uint32_t seg_len)
 {
@@ -369,8 +373,8 @@ void *odp_packet_push_head(odp_packet_t pkt, uint32_t len)
 static void _copy_head_metadata(struct rte_mbuf *newhead,
 				struct rte_mbuf *oldhead)
 {
-	rte_mbuf_refcnt_set(newhead, rte_mbuf_refcnt_read(oldhead));
-
+	/* Reference count is segment specific and must not be copied, as segments may be shared
+	 * with other packets through indirect mbufs */
 	_odp_packet_copy_md((odp_packet_hdr_t *)newhead, (odp_packet_hdr_t *)oldhead, 0);
 }
 
@@ -879,6 +883,10 @@ int odp_packet_copy_from_pkt(odp_packet_t dst, uint32_t dst_offset,
 		return 0;
 	}
 
+	if (!overlap && _odp_dma_pkt_copy_offload(len) &&
+	    _odp_dma_pkt_copy(dst, dst_offset, src, src_offset, len) == 0)
+		return 0;
+
 	while (len > 0) {
 		dst_map = odp_packet_offset(dst, dst_offset, &dst_seglen, NULL);
 		src_map = odp_packet_offset(src, src_offset, &src_seglen, NULL);
@@ -1656,13 +1664,69 @@ uint64_t odp_packet_tx_compl_to_u64(odp_packet_tx_compl_t tx_compl)
 	return _odp_pri(tx_compl);
 }
 
-odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
+/* Create a chain of indirect mbufs, which refer to packet data starting from 'offset' */
+static struct rte_mbuf *ref_chain_create(struct rte_mbuf *mb, uint32_t offset)
+{
+	struct rte_mempool *mp = mb->pool;
+	struct rte_mbuf *head = NULL, *tail = NULL, *mi;
+	uint32_t pkt_len = 0;
+	uint16_t nb_segs = 0;
+
+	while (offset >= mb->data_len) {
+		offset -= mb->data_len;
+		mb = mb->next;
+	}
+
+	for (; mb != NULL; mb = mb->next) {
+		if (odp_unlikely(mb->data_len == offset))
+			continue;
+
+		mi = rte_pktmbuf_alloc(mp);
+
+		if (odp_unlikely(mi == NULL)) {
+			rte_pktmbuf_free(head);
+			return NULL;
+		}
+
+		rte_pktmbuf_attach(mi, mb);
+		mi->data_off += offset;
+		mi->data_len -= offset;
+		offset = 0;
+
+		/* Data after the referenced segment belongs to the other packet. Hide it, so that
+		 * tailroom of a reference is always zero. */
+		mi->buf_len = mi->data_off + mi->data_len;
+
+		if (head == NULL)
+			head = mi;
+		else
+			tail->next = mi;
+
+		tail = mi;
+		pkt_len += mi->data_len;
+		nb_segs++;
+	}
+
+	head->pkt_len = pkt_len;
+	head->nb_segs = nb_segs;
+
+	return head;
+}
+
+static inline int ref_chain_possible(struct rte_mbuf *mb, struct rte_mbuf *hdr)
+{
+	pool_t *pool = _odp_pool_entry(((odp_packet_hdr_t *)mb)->event_hdr.pool);
+
+	/* Packet may be referred in place only if the resulting chain fits into a packet */
+	return hdr->pool == mb->pool && !pool->pool_ext &&
+		hdr->nb_segs + mb->nb_segs <= RTE_MBUF_MAX_NB_SEGS;
+}
+
+static odp_packet_t packet_ref_copy(odp_packet_t pkt, uint32_t offset)
 {
 	odp_packet_t new;
 	int ret;
 
-	_ODP_ASSERT(!odp_packet_has_ref(pkt));
-
 	new = odp_packet_copy(pkt, odp_packet_pool(pkt));
 
 	if (new == ODP_PACKET_INVALID) {
@@ -1681,31 +1745,90 @@ odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
 	return new;
 }
 
+odp_packet_t odp_packet_ref(odp_packet_t pkt, uint32_t offset)
+{
+	struct rte_mbuf *mb = pkt_to_mbuf(pkt);
+	struct rte_mbuf *hdr, *chain;
+	const uint32_t pkt_len = odp_packet_len(pkt);
+	uint32_t copy_len;
+	odp_packet_t new;
+
+	if (odp_unlikely(offset >= pkt_len)) {
+		_ODP_ERR("Bad offset: %u\n", offset);
+		return ODP_PACKET_INVALID;
+	}
+
+	/* Start of the shared data is copied into a new head segment, so that the reference
+	 * does not begin with an empty segment and has normal headroom. */
+	copy_len = _ODP_MIN(pkt_len - offset, PKT_REF_COPY_LEN);
+	new = packet_alloc(_odp_pool_entry(odp_packet_pool(pkt)), copy_len);
+
+	if (odp_unlikely(new == ODP_PACKET_INVALID))
+		return ODP_PACKET_INVALID;
+
+	hdr = pkt_to_mbuf(new);
+
+	if (odp_unlikely(!ref_chain_possible(mb, hdr))) {
+		odp_packet_free(new);
+		return packet_ref_copy(pkt, offset);
+	}
+
+	if (odp_packet_copy_to_mem(pkt, offset, copy_len, odp_packet_data(new))) {
+		odp_packet_free(new);
+		return ODP_PACKET_INVALID;
+	}
+
+	if (offset + copy_len == pkt_len)
+		return new;
+
+	chain = ref_chain_create(mb, offset + copy_len);
+
+	if (odp_unlikely(chain == NULL)) {
+		odp_packet_free(new);
+		return ODP_PACKET_INVALID;
+	}
+
+	if (odp_unlikely(rte_pktmbuf_chain(hdr, chain))) {
+		rte_pktmbuf_free(chain);
+		odp_packet_free(new);
+		return ODP_PACKET_INVALID;
+	}
+
+	return new;
+}
+
 odp_packet_t odp_packet_ref_pkt(odp_packet_t pkt, uint32_t offset,
 				odp_packet_t hdr)
 {
+	struct rte_mbuf *mb = pkt_to_mbuf(pkt);
+	struct rte_mbuf *chain;
 	odp_packet_t new;
 	int ret;
 
-	_ODP_ASSERT(!odp_packet_has_ref(pkt));
-
-	new = odp_packet_copy(pkt, odp_packet_pool(pkt));
-
-	if (new == ODP_PACKET_INVALID) {
-		_ODP_ERR("copy failed\n");
+	if (odp_unlikely(offset >= odp_packet_len(pkt))) {
+		_ODP_ERR("Bad offset: %u\n", offset);
 		return ODP_PACKET_INVALID;
 	}
 
-	if (offset) {
-		ret = odp_packet_trunc_head(&new, offset, NULL, NULL);
+	if (odp_likely(ref_chain_possible(mb, pkt_to_mbuf(hdr)))) {
+		chain = ref_chain_create(mb, offset);
+
+		if (odp_unlikely(chain == NULL))
+			return ODP_PACKET_INVALID;
 
-		if (ret < 0) {
-			_ODP_ERR("trunk_head failed\n");
-			odp_packet_free(new);
+		if (odp_unlikely(rte_pktmbuf_chain(pkt_to_mbuf(hdr), chain))) {
+			rte_pktmbuf_free(chain);
 			return ODP_PACKET_INVALID;
 		}
+
+		return hdr;
 	}
 
+	new = packet_ref_copy(pkt, offset);
+
+	if (new == ODP_PACKET_INVALID)
+		return ODP_PACKET_INVALID;
+
 	ret = odp_packet_concat(&hdr, new);
 
 	if (ret < 0) {
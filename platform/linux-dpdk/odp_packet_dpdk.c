@@ -25,12 +25,15 @@
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
 #include <odp_pool_internal.h>
+#include <odp_queue_if.h>
+#include <odp_schedule_if.h>
 #include <odp_string_internal.h>
 #include <protocols/eth.h>
 
 #include <rte_config.h>
 #include <rte_common.h>
 #include <rte_ethdev.h>
+#include <rte_event_eth_tx_adapter.h>
 #include <rte_ip_frag.h>
 #include <rte_udp.h>
 #include <rte_tcp.h>
@@ -91,6 +94,10 @@ typedef struct ODP_ALIGNED_CACHE {
 		uint8_t lockless_rx : 1;
 		/* No locking for tx */
 		uint8_t lockless_tx : 1;
+		/* Pktout event queues enqueue to eventdev Tx adapter */
+		uint8_t tx_adapter : 1;
+		/* Tx queues have been added to eventdev Tx adapter */
+		uint8_t tx_adapter_added : 1;
 	} flags;
 	/* Minimum RX burst size */
 	uint8_t min_rx_burst;
@@ -144,6 +151,10 @@ extern void *pktio_entry_ptr[CONFIG_PKTIO_ENTRIES];
 
 static uint32_t mtu_get_pkt_dpdk(pktio_entry_t *pktio_entry);
 
+static int tx_adapter_enq(odp_queue_t queue, _odp_event_hdr_t *event_hdr);
+
+static int tx_adapter_enq_multi(odp_queue_t queue, _odp_event_hdr_t *event_hdr[], int num);
+
 static inline int input_pkts(pktio_entry_t *pktio_entry, odp_packet_t pkt_table[], uint16_t num);
 
 static inline int input_pkts_minimal(pktio_entry_t *pktio_entry, odp_packet_t pkt_table[],
@@ -494,6 +505,22 @@ static int dpdk_output_queues_config(pktio_entry_t *pktio_entry,
 
 		_ODP_DBG("Port %" PRIu16 " TX queue %" PRIu32 " using %" PRIu16 " descriptors\n",
 			 pkt_dpdk->port_id, i, num_tx_desc);	}
+
+	/* Transmit packets from pktout event queues through eventdev Tx
+	 * adapter. Tx queue locks are not needed, as the adapter is the only
+	 * user of the Tx queues. */
+	pkt_dpdk->flags.tx_adapter = 0;
+	if (_odp_sched_id == _ODP_SCHED_ID_EVENTDEV &&
+	    _odp_eventdev_gbl->tx_adapter.enabled &&
+	    pktio_entry->param.out_mode == ODP_PKTOUT_MODE_QUEUE) {
+		for (uint32_t i = 0; i < p->num_queues; i++)
+			_odp_queue_fn->set_enq_deq_fn(pktio_entry->out_queue[i].queue,
+						      tx_adapter_enq, tx_adapter_enq_multi,
+						      NULL, NULL);
+
+		pkt_dpdk->flags.tx_adapter = 1;
+	}
+
 	return 0;
 }
 
@@ -754,6 +781,11 @@ static int close_pkt_dpdk(pktio_entry_t *pktio_entry)
 {
 	pkt_dpdk_t * const pkt_dpdk = pkt_priv(pktio_entry);
 
+	if (pkt_dpdk->flags.tx_adapter_added) {
+		_odp_tx_adapter_port_del(pkt_dpdk->port_id);
+		pkt_dpdk->flags.tx_adapter_added = 0;
+	}
+
 	if (_odp_eventdev_gbl &&
 	    _odp_eventdev_gbl->rx_adapter.status != RX_ADAPTER_INIT)
 		_odp_rx_adapter_port_stop(pkt_dpdk->port_id);
@@ -845,6 +877,12 @@ static int dpdk_start(pktio_entry_t *pktio_entry)
 	    pktio_entry->state == PKTIO_STATE_STOP_PENDING)
 		rte_eth_dev_stop(pkt_dpdk->port_id);
 
+	/* Tx queues are re-added to Tx adapter after reconfiguration */
+	if (pkt_dpdk->flags.tx_adapter_added) {
+		_odp_tx_adapter_port_del(port_id);
+		pkt_dpdk->flags.tx_adapter_added = 0;
+	}
+
 	ret = rte_eth_dev_info_get(port_id, &dev_info);
 	if (ret) {
 		_ODP_ERR("Failed to read device info: %d\n", ret);
@@ -873,6 +911,14 @@ static int dpdk_start(pktio_entry_t *pktio_entry)
 	if (dpdk_setup_eth_tx(pktio_entry, pkt_dpdk, &dev_info))
 		return -1;
 
+	if (pkt_dpdk->flags.tx_adapter) {
+		if (_odp_tx_adapter_port_add(port_id)) {
+			_ODP_ERR("Adding TX adapter queues failed: port=%" PRIu16 "\n", port_id);
+			return -1;
+		}
+		pkt_dpdk->flags.tx_adapter_added = 1;
+	}
+
 	/* Setup RX queues */
 	if (dpdk_setup_eth_rx(pktio_entry, pkt_dpdk, &dev_info))
 		return -1;
@@ -1258,6 +1304,41 @@ static int send_pkt_dpdk(pktio_entry_t *pktio_entry, int index,
 	return pkts;
 }
 
+static int tx_adapter_enq_multi(odp_queue_t queue, _odp_event_hdr_t *event_hdr[], int num)
+{
+	odp_pktout_queue_t pktout = _odp_queue_fn->get_pktout(queue);
+	pktio_entry_t *pktio_entry = get_pktio_entry(pktout.pktio);
+	pkt_dpdk_t * const pkt_dpdk = pkt_priv(pktio_entry);
+	const uint8_t chksum_insert_ena = pktio_entry->enabled.chksum_insert;
+	odp_pktout_config_opt_t *pktout_cfg = &pktio_entry->config.pktout;
+	odp_pktout_config_opt_t *pktout_capa = &pktio_entry->capa.config.pktout;
+	struct rte_mbuf *mbuf[num];
+
+	if (odp_unlikely(pktio_entry->state != PKTIO_STATE_STARTED))
+		return 0;
+
+	for (int i = 0; i < num; i++) {
+		odp_packet_t pkt = packet_from_event_hdr(event_hdr[i]);
+
+		mbuf[i] = pkt_to_mbuf(pkt);
+
+		if (chksum_insert_ena)
+			pkt_set_ol_tx(pktout_cfg, pktout_capa, packet_hdr(pkt), mbuf[i],
+				      rte_pktmbuf_mtod(mbuf[i], char *));
+
+		/* Tx adapter selects the output port and queue from mbuf */
+		mbuf[i]->port = pkt_dpdk->port_id;
+		rte_event_eth_tx_adapter_txq_set(mbuf[i], pktout.index);
+	}
+
+	return _odp_tx_adapter_enq(mbuf, num, pktout.index);
+}
+
+static int tx_adapter_enq(odp_queue_t queue, _odp_event_hdr_t *event_hdr)
+{
+	return tx_adapter_enq_multi(queue, &event_hdr, 1) == 1 ? 0 : -1;
+}
+
 static uint32_t _dpdk_vdev_mtu(uint16_t port_id)
 {
 	struct rte_eth_dev_info dev_info;
@@ -118,9 +118,37 @@ static int read_config_file(eventdev_global_t *eventdev)
 		_ODP_ERR("Config option '%s' not found.\n", str);
 		return -1;
 	}
-	_ODP_PRINT("%s: %i\n\n", str, val);
+	_ODP_PRINT("%s: %i\n", str, val);
 	eventdev->num_event_ports = val;
 
+	str = "sched_eventdev.crypto_adapter";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	_ODP_PRINT("%s: %i\n", str, val);
+	eventdev->crypto_adapter.enabled = !!val;
+
+	str = "sched_eventdev.tx_adapter";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	_ODP_PRINT("%s: %i\n", str, val);
+	eventdev->tx_adapter.enabled = !!val;
+
+	str = "sched_eventdev.timer_adapters";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	if (val < 0 || val > MAX_TIMER_ADAPTERS) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+	_ODP_PRINT("%s: %i\n\n", str, val);
+	eventdev->timer_adapter.num_ports = val;
+
 	return 0;
 }
 
@@ -204,25 +232,64 @@ static int alloc_queues(eventdev_global_t *eventdev,
 			const struct rte_event_dev_info *info)
 {
 	int num_queues;
+	/* Tx adapter requires one queue for internal use */
+	int num_internal = eventdev->tx_adapter.enabled ? 1 : 0;
 
 	if (!eventdev->event_queue.num_atomic &&
 	    !eventdev->event_queue.num_ordered &&
 	    !eventdev->event_queue.num_parallel) {
-		uint8_t queue_per_type = info->max_event_queues / 3;
+		uint8_t queue_per_type;
+
+		/* Schedule types are selected at queue create time */
+		eventdev->event_queue.dynamic = 1;
+		eventdev->event_queue.all_types =
+			!!(info->event_dev_cap & RTE_EVENT_DEV_CAP_QUEUE_ALL_TYPES);
 
-		/* Divide eventdev queues evenly to ODP queue types */
+		num_queues = info->max_event_queues - num_internal;
+		queue_per_type = num_queues / 3;
+
+		/* Initial division of eventdev queues to ODP queue types, when
+		 * queue types have to be configured. Free queues are
+		 * reconfigured on demand. */
 		eventdev->event_queue.num_atomic = queue_per_type;
 		eventdev->event_queue.num_ordered = queue_per_type;
-		eventdev->event_queue.num_parallel = queue_per_type;
-
-		num_queues = 3 * queue_per_type;
+		eventdev->event_queue.num_parallel = num_queues - 2 * queue_per_type;
 	} else {
 		num_queues = eventdev->event_queue.num_atomic +
 			     eventdev->event_queue.num_ordered +
 			     eventdev->event_queue.num_parallel;
 	}
 
-	return num_queues;
+	eventdev->event_queue.num_queues = num_queues;
+
+	/* Internal queues follow the ODP scheduled queues */
+	eventdev->tx_adapter.queue_id = num_queues;
+
+	return num_queues + num_internal;
+}
+
+static int setup_queues_all_types(uint8_t dev_id, uint8_t num_queues,
+				  uint32_t num_flows)
+{
+	uint8_t i;
+
+	for (i = 0; i < num_queues; i++) {
+		struct rte_event_queue_conf queue_conf;
+
+		if (rte_event_queue_default_conf_get(dev_id, i, &queue_conf)) {
+			_ODP_ERR("rte_event_queue_default_conf_get failed\n");
+			return -1;
+		}
+		/* Schedule type is selected per event */
+		queue_conf.event_queue_cfg |= RTE_EVENT_QUEUE_CFG_ALL_TYPES;
+		queue_conf.nb_atomic_flows = num_flows;
+
+		if (rte_event_queue_setup(dev_id, i, &queue_conf)) {
+			_ODP_ERR("rte_event_queue_setup failed\n");
+			return -1;
+		}
+	}
+	return 0;
 }
 
 static int setup_queues(uint8_t dev_id, uint8_t first_queue_id,
@@ -261,6 +328,13 @@ static int configure_queues(uint8_t dev_id, uint32_t num_flows)
 	uint8_t first_queue_id;
 	uint8_t num_queues;
 
+	if (_odp_eventdev_gbl->event_queue.all_types) {
+		if (setup_queues_all_types(dev_id, _odp_eventdev_gbl->event_queue.num_queues,
+					   num_flows))
+			return -1;
+		goto internal_queues;
+	}
+
 	num_queues = event_queue_ids(ODP_SCHED_SYNC_ATOMIC, &first_queue_id);
 	if (setup_queues(dev_id, first_queue_id, num_queues, num_flows,
 			 ODP_SCHED_SYNC_ATOMIC))
@@ -276,6 +350,25 @@ static int configure_queues(uint8_t dev_id, uint32_t num_flows)
 			 ODP_SCHED_SYNC_ORDERED))
 		return -1;
 
+internal_queues:
+	/* Tx adapter queue is atomic to maintain packet order per Tx queue */
+	if (_odp_eventdev_gbl->tx_adapter.enabled) {
+		struct rte_event_queue_conf queue_conf;
+		uint8_t queue_id = _odp_eventdev_gbl->tx_adapter.queue_id;
+
+		if (rte_event_queue_default_conf_get(dev_id, queue_id, &queue_conf)) {
+			_ODP_ERR("rte_event_queue_default_conf_get failed\n");
+			return -1;
+		}
+		queue_conf.schedule_type = RTE_SCHED_TYPE_ATOMIC;
+		queue_conf.nb_atomic_flows = num_flows;
+
+		if (rte_event_queue_setup(dev_id, queue_id, &queue_conf)) {
+			_ODP_ERR("rte_event_queue_setup failed\n");
+			return -1;
+		}
+	}
+
 	return 0;
 }
 
@@ -368,6 +461,8 @@ static int init_event_dev(void)
 	uint8_t dummy_links[RTE_EVENT_MAX_QUEUES_PER_DEV];
 	struct rte_event_dev_info info;
 	struct rte_event_dev_config config;
+	uint8_t num_timer_ports;
+	uint8_t num_workers;
 	int num_dummy_links;
 	int ret;
 	int i;
@@ -384,6 +479,9 @@ static int init_event_dev(void)
 	_odp_eventdev_gbl->rx_adapter.id = rx_adapter_id;
 	_odp_eventdev_gbl->rx_adapter.status = RX_ADAPTER_INIT;
 	odp_ticketlock_init(&_odp_eventdev_gbl->rx_adapter.lock);
+	odp_ticketlock_init(&_odp_eventdev_gbl->tx_adapter.lock);
+	odp_ticketlock_init(&_odp_eventdev_gbl->event_queue.lock);
+	odp_atomic_init_u32(&_odp_eventdev_gbl->num_enq_started, 0);
 	odp_atomic_init_u32(&_odp_eventdev_gbl->num_started, 0);
 
 	odp_ticketlock_init(&_odp_eventdev_gbl->port_lock);
@@ -413,9 +511,24 @@ static int init_event_dev(void)
 	/* RX adapter requires additional port which is reserved when
 	 * rte_event_eth_rx_adapter_queue_add() is called. */
 	config.nb_event_ports -= 1;
+	/* Software crypto adapter requires an additional port as well */
+	if (_odp_eventdev_gbl->crypto_adapter.enabled)
+		config.nb_event_ports -= 1;
+	/* Software Tx adapter reserves a port when it is created */
+	if (_odp_eventdev_gbl->tx_adapter.enabled)
+		config.nb_event_ports -= 1;
+	/* Timer adapters use ports configured after the worker ports */
+	num_timer_ports = _odp_eventdev_gbl->timer_adapter.num_ports;
+	if (num_timer_ports >= config.nb_event_ports) {
+		_ODP_ERR("Too many timer adapter ports: %" PRIu8 "\n", num_timer_ports);
+		return -1;
+	}
+	config.nb_event_ports -= num_timer_ports;
 	if (_odp_eventdev_gbl->num_event_ports &&
 	    _odp_eventdev_gbl->num_event_ports < config.nb_event_ports)
 		config.nb_event_ports = _odp_eventdev_gbl->num_event_ports;
+	num_workers = config.nb_event_ports;
+	config.nb_event_ports += num_timer_ports;
 
 	num_flows = (EVENT_QUEUE_FLOWS < info.max_event_queue_flows) ?
 			EVENT_QUEUE_FLOWS : info.max_event_queue_flows;
@@ -436,7 +549,8 @@ static int init_event_dev(void)
 		return -1;
 	}
 	_odp_eventdev_gbl->config = config;
-	_odp_eventdev_gbl->num_event_ports = config.nb_event_ports;
+	_odp_eventdev_gbl->num_event_ports = num_workers;
+	_odp_eventdev_gbl->timer_adapter.first_port = num_workers;
 
 	if (configure_ports(dev_id, &config)) {
 		_ODP_ERR("Configuring eventdev ports failed\n");
@@ -586,6 +700,9 @@ static int queue_term_global(void)
 		UNLOCK(queue);
 	}
 
+	if (_odp_tx_adapter_close())
+		ret = -1;
+
 	if (_odp_rx_adapter_close())
 		ret = -1;
 
@@ -640,6 +757,102 @@ static uint32_t queue_lock_count(odp_queue_t handle)
 		queue->param.sched.lock_count : 0;
 }
 
+/* Event device holds no events and is not used by adapters or schedulers */
+static int event_dev_idle(void)
+{
+	return !odp_atomic_load_u32(&_odp_eventdev_gbl->num_started) &&
+	       !odp_atomic_load_u32(&_odp_eventdev_gbl->num_enq_started) &&
+	       _odp_eventdev_gbl->rx_adapter.status == RX_ADAPTER_INIT &&
+	       !_odp_eventdev_gbl->tx_adapter.running;
+}
+
+/* Change schedule type of a free eventdev queue. Queue lock must be held. */
+static int event_queue_retype(queue_entry_t *queue, odp_schedule_sync_t sync)
+{
+	uint8_t dev_id = _odp_eventdev_gbl->dev_id;
+	uint8_t dummy_links[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	odp_schedule_sync_t old_sync = queue->sync;
+	int num_dummy_links;
+	int ret = 0;
+
+	/* Queues can be set up only while the device is stopped */
+	rte_event_dev_stop(dev_id);
+
+	if (setup_queues(dev_id, queue->index, 1,
+			 _odp_eventdev_gbl->config.nb_event_queue_flows, sync)) {
+		_ODP_ERR("Eventdev queue %" PRIu32 " reconfiguration failed\n", queue->index);
+		ret = -1;
+	}
+
+	num_dummy_links = _odp_dummy_link_queues(dev_id, dummy_links,
+						 _odp_eventdev_gbl->config.nb_event_queues);
+
+	if (rte_event_dev_start(dev_id)) {
+		_ODP_ERR("rte_event_dev_start failed\n");
+		ret = -1;
+	}
+
+	if (num_dummy_links < 0 ||
+	    _odp_dummy_unlink_queues(dev_id, dummy_links, num_dummy_links))
+		ret = -1;
+
+	if (ret == 0) {
+		if (old_sync == ODP_SCHED_SYNC_ATOMIC)
+			_odp_eventdev_gbl->event_queue.num_atomic--;
+		else if (old_sync == ODP_SCHED_SYNC_ORDERED)
+			_odp_eventdev_gbl->event_queue.num_ordered--;
+		else
+			_odp_eventdev_gbl->event_queue.num_parallel--;
+
+		if (sync == ODP_SCHED_SYNC_ATOMIC)
+			_odp_eventdev_gbl->event_queue.num_atomic++;
+		else if (sync == ODP_SCHED_SYNC_ORDERED)
+			_odp_eventdev_gbl->event_queue.num_ordered++;
+		else
+			_odp_eventdev_gbl->event_queue.num_parallel++;
+	}
+
+	return ret;
+}
+
+/* Allocate a scheduled queue by reconfiguring the schedule type of a free
+ * eventdev queue. Event device has to be restarted for this, which is
+ * possible only before any events have been enqueued or scheduled. */
+static queue_entry_t *sched_queue_retype_alloc(const char *name,
+					       const odp_queue_param_t *param)
+{
+	queue_entry_t *queue = NULL;
+	uint32_t i;
+
+	odp_ticketlock_lock(&_odp_eventdev_gbl->event_queue.lock);
+
+	if (!event_dev_idle()) {
+		odp_ticketlock_unlock(&_odp_eventdev_gbl->event_queue.lock);
+		_ODP_DBG("Eventdev queue reconfiguration not possible after start\n");
+		return NULL;
+	}
+
+	for (i = 0; i < _odp_eventdev_gbl->event_queue.num_queues; i++) {
+		queue_entry_t *cur = qentry_from_index(i);
+
+		LOCK(cur);
+		if (cur->status == QUEUE_STATUS_FREE) {
+			if (event_queue_retype(cur, param->sched.sync) == 0 &&
+			    queue_init(cur, name, param) == 0) {
+				cur->status = QUEUE_STATUS_SCHED;
+				queue = cur;
+			}
+			UNLOCK(cur);
+			break;
+		}
+		UNLOCK(cur);
+	}
+
+	odp_ticketlock_unlock(&_odp_eventdev_gbl->event_queue.lock);
+
+	return queue;
+}
+
 static odp_queue_t queue_create(const char *name,
 				const odp_queue_param_t *param)
 {
@@ -680,7 +893,7 @@ static odp_queue_t queue_create(const char *name,
 		/* Start scheduled queue indices from zero to enable direct
 		 * mapping to scheduler implementation indices. */
 		i = 0;
-		max_idx = RTE_EVENT_MAX_QUEUES_PER_DEV;
+		max_idx = _odp_eventdev_gbl->event_queue.num_queues;
 	} else {
 		i = RTE_EVENT_MAX_QUEUES_PER_DEV;
 		/* All internal queues are of type plain */
@@ -694,6 +907,7 @@ static odp_queue_t queue_create(const char *name,
 			continue;
 
 		if (type == ODP_QUEUE_TYPE_SCHED &&
+		    !_odp_eventdev_gbl->event_queue.all_types &&
 		    queue->sync != param->sched.sync)
 			continue;
 
@@ -716,6 +930,14 @@ static odp_queue_t queue_create(const char *name,
 		UNLOCK(queue);
 	}
 
+	/* Reconfigure a free eventdev queue of another schedule type */
+	if (handle == ODP_QUEUE_INVALID && type == ODP_QUEUE_TYPE_SCHED &&
+	    _odp_eventdev_gbl->event_queue.dynamic) {
+		queue = sched_queue_retype_alloc(name, param);
+		if (queue)
+			handle = queue_from_qentry(queue);
+	}
+
 	if (handle == ODP_QUEUE_INVALID) {
 		_ODP_ERR("No free queues left\n");
 		return ODP_QUEUE_INVALID;
@@ -1080,6 +1302,12 @@ static inline int _sched_queue_enq_multi(odp_queue_t handle,
 		return 0;
 	}
 
+	/* Eventdev queues cannot be reconfigured after this */
+	if (odp_unlikely(!_odp_eventdev_local.enq_started)) {
+		_odp_eventdev_local.enq_started = 1;
+		odp_atomic_inc_u32(&_odp_eventdev_gbl->num_enq_started);
+	}
+
 	for (i = 0; i < num; i++) {
 		ev[i].flow_id = 0;
 		ev[i].op = RTE_EVENT_OP_NEW;
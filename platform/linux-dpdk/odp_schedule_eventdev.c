@@ -14,6 +14,7 @@
 #include <odp/api/plat/schedule_inline_types.h>
 
 #include <odp_config_internal.h>
+#include <odp_crypto_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_eventdev_internal.h>
 #include <odp_packet_io_internal.h>
@@ -25,6 +26,7 @@
 #include <rte_ethdev.h>
 #include <rte_eventdev.h>
 #include <rte_event_eth_rx_adapter.h>
+#include <rte_event_eth_tx_adapter.h>
 #include <rte_service.h>
 
 #include <inttypes.h>
@@ -323,6 +325,177 @@ void _odp_rx_adapter_port_stop(uint16_t port_id)
 	rte_eth_dev_stop(port_id);
 }
 
+static int tx_adapter_create(uint8_t dev_id, uint8_t tx_adapter_id,
+			     const struct rte_event_dev_config *config)
+{
+	struct rte_event_port_conf port_config;
+	uint32_t capa = 0;
+	uint16_t eth_port;
+	int ret;
+
+	memset(&port_config, 0, sizeof(struct rte_event_port_conf));
+	port_config.new_event_threshold = config->nb_events_limit;
+	port_config.dequeue_depth = config->nb_event_port_dequeue_depth;
+	port_config.enqueue_depth = config->nb_event_port_enqueue_depth;
+	ret = rte_event_eth_tx_adapter_create(tx_adapter_id, dev_id,
+					      &port_config);
+	if (ret) {
+		_ODP_ERR("rte_event_eth_tx_adapter_create failed: %d\n", ret);
+		return -1;
+	}
+
+	/* Workers may enqueue directly to the adapter only when all ethernet
+	 * devices have an internal event port */
+	_odp_eventdev_gbl->tx_adapter.internal_port = 1;
+	RTE_ETH_FOREACH_DEV(eth_port) {
+		if (rte_event_eth_tx_adapter_caps_get(dev_id, eth_port, &capa) ||
+		    !(capa & RTE_EVENT_ETH_TX_ADAPTER_CAP_INTERNAL_PORT))
+			_odp_eventdev_gbl->tx_adapter.internal_port = 0;
+	}
+
+	if (!_odp_eventdev_gbl->tx_adapter.internal_port) {
+		uint8_t queue_id = _odp_eventdev_gbl->tx_adapter.queue_id;
+		uint8_t port_id;
+
+		ret = rte_event_eth_tx_adapter_event_port_get(tx_adapter_id,
+							      &port_id);
+		if (ret) {
+			_ODP_ERR("rte_event_eth_tx_adapter_event_port_get failed: %d\n", ret);
+			goto error;
+		}
+
+		ret = rte_event_port_link(dev_id, port_id, &queue_id, NULL, 1);
+		if (ret != 1) {
+			_ODP_ERR("rte_event_port_link failed: %d\n", ret);
+			goto error;
+		}
+	}
+
+	return 0;
+
+error:
+	rte_event_eth_tx_adapter_free(tx_adapter_id);
+	return -1;
+}
+
+int _odp_tx_adapter_port_add(uint16_t port_id)
+{
+	uint8_t tx_adapter_id = _odp_eventdev_gbl->tx_adapter.id;
+	int ret = 0;
+
+	odp_ticketlock_lock(&_odp_eventdev_gbl->tx_adapter.lock);
+
+	if (!_odp_eventdev_gbl->tx_adapter.running) {
+		uint32_t service_id = 0;
+		int sret;
+
+		if (tx_adapter_create(_odp_eventdev_gbl->dev_id, tx_adapter_id,
+				      &_odp_eventdev_gbl->config)) {
+			_ODP_ERR("Creating eventdev TX adapter failed\n");
+			ret = -1;
+			goto unlock;
+		}
+
+		sret = rte_event_eth_tx_adapter_service_id_get(tx_adapter_id,
+							       &service_id);
+		if (sret && sret != -ESRCH) {
+			_ODP_ERR("Unable to retrieve service ID\n");
+			goto free_adapter;
+		} else if (!sret && _odp_service_setup(service_id)) {
+			_ODP_ERR("Unable to start TX service\n");
+			goto free_adapter;
+		}
+
+		if (rte_event_eth_tx_adapter_start(tx_adapter_id)) {
+			_ODP_ERR("Unable to start TX adapter\n");
+			goto free_adapter;
+		}
+
+		_odp_eventdev_gbl->tx_adapter.running = 1;
+	}
+
+	if (rte_event_eth_tx_adapter_queue_add(tx_adapter_id, port_id, -1)) {
+		_ODP_ERR("rte_event_eth_tx_adapter_queue_add failed\n");
+		ret = -1;
+	}
+
+unlock:
+	odp_ticketlock_unlock(&_odp_eventdev_gbl->tx_adapter.lock);
+
+	return ret;
+
+free_adapter:
+	rte_event_eth_tx_adapter_free(tx_adapter_id);
+	odp_ticketlock_unlock(&_odp_eventdev_gbl->tx_adapter.lock);
+
+	return -1;
+}
+
+void _odp_tx_adapter_port_del(uint16_t port_id)
+{
+	if (!_odp_eventdev_gbl->tx_adapter.running)
+		return;
+
+	if (rte_event_eth_tx_adapter_queue_del(_odp_eventdev_gbl->tx_adapter.id, port_id, -1))
+		_ODP_ERR("Failed to delete TX queue\n");
+}
+
+int _odp_tx_adapter_close(void)
+{
+	uint8_t tx_adapter_id = _odp_eventdev_gbl->tx_adapter.id;
+	int ret = 0;
+
+	if (!_odp_eventdev_gbl->tx_adapter.running)
+		return ret;
+
+	if (rte_event_eth_tx_adapter_stop(tx_adapter_id)) {
+		_ODP_ERR("Failed to stop TX adapter\n");
+		ret = -1;
+	}
+
+	if (rte_event_eth_tx_adapter_free(tx_adapter_id)) {
+		_ODP_ERR("Failed to free TX adapter\n");
+		ret = -1;
+	}
+
+	_odp_eventdev_gbl->tx_adapter.running = 0;
+
+	return ret;
+}
+
+int _odp_tx_adapter_enq(struct rte_mbuf *mbuf[], int num, uint16_t txq)
+{
+	struct rte_event ev[CONFIG_BURST_SIZE];
+	uint8_t dev_id = _odp_eventdev_gbl->dev_id;
+	uint8_t port_id = _odp_eventdev_local.port_id;
+	int i;
+
+	if (odp_unlikely(port_id >= _odp_eventdev_gbl->num_event_ports)) {
+		_ODP_ERR("Max %" PRIu8 " scheduled workers supported\n",
+			 _odp_eventdev_gbl->num_event_ports);
+		return 0;
+	}
+
+	if (num > CONFIG_BURST_SIZE)
+		num = CONFIG_BURST_SIZE;
+
+	for (i = 0; i < num; i++) {
+		ev[i].flow_id = txq;
+		ev[i].op = RTE_EVENT_OP_NEW;
+		ev[i].sched_type = RTE_SCHED_TYPE_ATOMIC;
+		ev[i].queue_id = _odp_eventdev_gbl->tx_adapter.queue_id;
+		ev[i].event_type = RTE_EVENT_TYPE_CPU;
+		ev[i].sub_event_type = 0;
+		ev[i].priority = RTE_EVENT_DEV_PRIORITY_NORMAL;
+		ev[i].mbuf = mbuf[i];
+	}
+
+	if (_odp_eventdev_gbl->tx_adapter.internal_port)
+		return rte_event_eth_tx_adapter_enqueue(dev_id, port_id, ev, num, 0);
+
+	return rte_event_enqueue_new_burst(dev_id, port_id, ev, num);
+}
+
 static int schedule_init_global(void)
 {
 	_ODP_DBG("Using eventdev scheduler\n");
@@ -571,6 +744,21 @@ static inline uint16_t event_input(struct rte_event ev[], odp_event_t out_ev[],
 			continue;
 		}
 
+		/* Crypto operations completed by crypto adapter */
+		if (event->event_type == RTE_EVENT_TYPE_CRYPTODEV) {
+			out_ev[num_events++] = _odp_crypto_adapter_event(event->event_ptr);
+			continue;
+		}
+
+		/* Timeouts from timer adapter */
+		if (event->event_type == RTE_EVENT_TYPE_TIMER) {
+			odp_event_t tmo_ev = _odp_timer_adapter_event(event->event_ptr);
+
+			if (odp_likely(tmo_ev != ODP_EVENT_INVALID))
+				out_ev[num_events++] = tmo_ev;
+			continue;
+		}
+
 		out_ev[num_events++] = mbuf_to_event(event->mbuf);
 	}
 
@@ -647,6 +835,7 @@ static inline int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 		num_deq = input_cached(out_ev, max_num, out_queue);
 	} else {
 		while (1) {
+			crypto_compl_poll();
 			num_deq = rte_event_dequeue_burst(dev_id, port_id, ev,
 							  max_num, 0);
 			if (num_deq) {
@@ -1028,9 +1217,14 @@ static int schedule_capability(odp_schedule_capability_t *capa)
 
 	memset(capa, 0, sizeof(odp_schedule_capability_t));
 
-	max_sched = RTE_MAX(RTE_MAX(_odp_eventdev_gbl->event_queue.num_atomic,
-				    _odp_eventdev_gbl->event_queue.num_ordered),
-			    _odp_eventdev_gbl->event_queue.num_parallel);
+	/* With dynamic allocation, any free eventdev queue may be used for any
+	 * schedule type */
+	if (_odp_eventdev_gbl->event_queue.dynamic)
+		max_sched = _odp_eventdev_gbl->event_queue.num_queues;
+	else
+		max_sched = RTE_MAX(RTE_MAX(_odp_eventdev_gbl->event_queue.num_atomic,
+					    _odp_eventdev_gbl->event_queue.num_ordered),
+				    _odp_eventdev_gbl->event_queue.num_parallel);
 	capa->max_queues        = RTE_MIN(CONFIG_MAX_SCHED_QUEUES, max_sched);
 	capa->max_queue_size    = _odp_eventdev_gbl->config.nb_events_limit;
 	capa->max_ordered_locks = schedule_max_ordered_locks();
@@ -20,19 +20,24 @@
 #include <odp/api/plat/timer_inline_types.h>
 
 #include <odp_debug_internal.h>
+#include <odp_eventdev_internal.h>
 #include <odp_init_internal.h>
 #include <odp_libconfig_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_pool_internal.h>
 #include <odp_queue_if.h>
 #include <odp_ring_mpmc_rst_u32_internal.h>
+#include <odp_schedule_if.h>
 #include <odp_string_internal.h>
 #include <odp_thread_internal.h>
 #include <odp_timer_internal.h>
 
 #include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_event_timer_adapter.h>
 #include <rte_timer.h>
 
+#include <errno.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
@@ -109,7 +114,13 @@ typedef struct {
 	/* Periodic ticks fractional part accumulator. */
 	uint32_t periodic_ticks_frac_acc;
 
-	struct rte_timer     rte_timer;
+	/* Timer is run by the event timer adapter of the timer pool */
+	uint8_t              use_adapter;
+
+	union {
+		struct rte_timer       rte_timer;
+		struct rte_event_timer ev_timer;
+	};
 
 } timer_entry_t;
 
@@ -136,6 +147,12 @@ typedef struct timer_pool_s {
 	uint64_t max_multiplier;
 	uint8_t periodic;
 
+	/* Event timer adapter, or NULL when timers are run with rte_timer */
+	struct rte_event_timer_adapter *adapter;
+	uint64_t adapter_tick_ns;
+	uint8_t adapter_port;
+	uint8_t adapter_slot;
+
 } timer_pool_t;
 #pragma GCC diagnostic pop
 
@@ -165,6 +182,12 @@ typedef struct {
 	uint8_t use_alternate;
 	timer_ops_t ops;
 
+	/* Number of timer pools and timers which need inline polling */
+	int num_inline_pools;
+	uint32_t num_inline_timers;
+	/* Timer adapter slots in use (one bit per reserved event port) */
+	uint32_t adapter_slot_mask;
+
 } timer_global_t;
 
 typedef struct timer_local_t {
@@ -477,6 +500,195 @@ static inline uint64_t tmo_ticks_to_ns_round_up(uint64_t tmo_ticks)
 	return tmo_ns;
 }
 
+/* Update inline timer polling state. Timer global lock must be held. */
+static void inline_timers_update(void)
+{
+	odp_global_rw->inline_timers = timer_global->num_inline_pools > 0 ||
+				       timer_global->num_inline_timers > 0;
+}
+
+static int timer_adapter_port_cb(uint16_t id ODP_UNUSED, uint8_t event_dev_id ODP_UNUSED,
+				 uint8_t *event_port_id, void *conf_arg)
+{
+	timer_pool_t *timer_pool = conf_arg;
+
+	/* Use an event port reserved during event device initialization */
+	*event_port_id = timer_pool->adapter_port;
+
+	return 0;
+}
+
+/* Create an event timer adapter for a timer pool. Timer global lock must be
+ * held. */
+static int timer_adapter_create(timer_pool_t *timer_pool)
+{
+	struct rte_event_timer_adapter_conf conf;
+	struct rte_event_timer_adapter_info info;
+	struct rte_event_timer_adapter *adapter;
+	uint32_t service_id;
+	uint32_t num_slots;
+	uint32_t slot;
+	int ret;
+
+	if (_odp_sched_id != _ODP_SCHED_ID_EVENTDEV)
+		return -1;
+
+	num_slots = _odp_eventdev_gbl->timer_adapter.num_ports;
+
+	for (slot = 0; slot < num_slots; slot++) {
+		if (!(timer_global->adapter_slot_mask & (1u << slot)))
+			break;
+	}
+	if (slot == num_slots)
+		return -1;
+
+	memset(&conf, 0, sizeof(struct rte_event_timer_adapter_conf));
+	conf.event_dev_id = _odp_eventdev_gbl->dev_id;
+	conf.timer_adapter_id = slot;
+	conf.socket_id = rte_socket_id();
+	conf.clk_src = RTE_EVENT_TIMER_ADAPTER_CPU_CLK;
+	conf.timer_tick_ns = timer_pool->param.res_ns;
+	conf.max_tmo_ns = timer_pool->param.max_tmo ? timer_pool->param.max_tmo : MAX_TMO_NS;
+	conf.nb_timers = timer_pool->param.num_timers;
+	conf.flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES;
+
+	timer_pool->adapter_port = _odp_eventdev_gbl->timer_adapter.first_port + slot;
+
+	adapter = rte_event_timer_adapter_create_ext(&conf, timer_adapter_port_cb, timer_pool);
+	if (adapter == NULL) {
+		_ODP_DBG("Event timer adapter create failed: %d\n", rte_errno);
+		return -1;
+	}
+
+	if (rte_event_timer_adapter_get_info(adapter, &info)) {
+		_ODP_ERR("Event timer adapter info failed\n");
+		goto error;
+	}
+
+	ret = rte_event_timer_adapter_service_id_get(adapter, &service_id);
+	if (ret == 0) {
+		if (_odp_service_setup(service_id)) {
+			_ODP_ERR("Unable to setup timer adapter service\n");
+			goto error;
+		}
+	} else if (ret != -ESRCH) {
+		_ODP_ERR("Event timer adapter service id get failed: %d\n", ret);
+		goto error;
+	}
+
+	if (rte_event_timer_adapter_start(adapter)) {
+		_ODP_ERR("Event timer adapter start failed\n");
+		goto error;
+	}
+
+	timer_pool->adapter = adapter;
+	timer_pool->adapter_tick_ns = info.conf.timer_tick_ns;
+	timer_pool->adapter_slot = slot;
+	timer_global->adapter_slot_mask |= 1u << slot;
+
+	return 0;
+
+error:
+	rte_event_timer_adapter_free(adapter);
+	return -1;
+}
+
+/* Destroy the event timer adapter of a timer pool. Timer global lock must be
+ * held. */
+static void timer_adapter_destroy(timer_pool_t *timer_pool)
+{
+	if (rte_event_timer_adapter_stop(timer_pool->adapter))
+		_ODP_ERR("Event timer adapter stop failed\n");
+
+	if (rte_event_timer_adapter_free(timer_pool->adapter))
+		_ODP_ERR("Event timer adapter free failed\n");
+
+	timer_global->adapter_slot_mask &= ~(1u << timer_pool->adapter_slot);
+	timer_pool->adapter = NULL;
+}
+
+static void timer_adapter_timer_init(timer_entry_t *timer, odp_queue_t queue)
+{
+	queue_entry_t *queue_entry = qentry_from_handle(queue);
+	struct rte_event_timer *ev_timer = &timer->ev_timer;
+
+	memset(ev_timer, 0, sizeof(struct rte_event_timer));
+	ev_timer->ev.op = RTE_EVENT_OP_NEW;
+	ev_timer->ev.queue_id = queue_entry->index;
+	ev_timer->ev.sched_type = event_schedule_type(queue_entry->param.sched.sync);
+	ev_timer->ev.priority = queue_entry->eventdev.prio;
+	ev_timer->ev.event_type = RTE_EVENT_TYPE_TIMER;
+	ev_timer->ev.event_ptr = timer;
+	ev_timer->state = RTE_EVENT_TIMER_NOT_ARMED;
+
+	timer->use_adapter = 1;
+}
+
+static inline int timer_adapter_arm(timer_entry_t *timer, uint64_t rel_tick)
+{
+	timer_pool_t *timer_pool = timer->timer_pool;
+	struct rte_event_timer *ev_timer = &timer->ev_timer;
+	uint64_t tick_ns = timer_pool->adapter_tick_ns;
+	uint64_t tmo_ns = tmo_ticks_to_ns_round_up(rel_tick);
+
+	/* An armed event timer must be cancelled before rearming. Cancel fails
+	 * when the timer has already expired. */
+	if (ev_timer->state == RTE_EVENT_TIMER_ARMED &&
+	    rte_event_timer_cancel_burst(timer_pool->adapter, &ev_timer, 1) != 1)
+		return -1;
+
+	ev_timer->state = RTE_EVENT_TIMER_NOT_ARMED;
+	ev_timer->timeout_ticks = (tmo_ns + tick_ns - 1) / tick_ns;
+	if (ev_timer->timeout_ticks == 0)
+		ev_timer->timeout_ticks = 1;
+
+	if (odp_unlikely(rte_event_timer_arm_burst(timer_pool->adapter, &ev_timer, 1) != 1))
+		return -1;
+
+	return 0;
+}
+
+/* Stop a timer. Returns 0 when the timer was stopped before it expired. */
+static inline int timer_entry_stop(timer_entry_t *timer)
+{
+	if (timer->use_adapter) {
+		struct rte_event_timer *ev_timer = &timer->ev_timer;
+
+		if (ev_timer->state != RTE_EVENT_TIMER_ARMED)
+			return -1;
+
+		return rte_event_timer_cancel_burst(timer->timer_pool->adapter, &ev_timer, 1) == 1 ?
+			0 : -1;
+	}
+
+	return timer_global->ops.stop(&timer->rte_timer);
+}
+
+odp_event_t _odp_timer_adapter_event(void *ptr)
+{
+	timer_entry_t *timer = ptr;
+	odp_event_t event;
+
+	odp_ticketlock_lock(&timer->lock);
+
+	/* Timer was cancelled or freed while the expiration event was in
+	 * flight */
+	if (timer->state != TICKING) {
+		odp_ticketlock_unlock(&timer->lock);
+		return ODP_EVENT_INVALID;
+	}
+
+	event = timer->tmo_event;
+	timer->state = EXPIRED;
+
+	if (!timer->timer_pool->periodic)
+		timer->tmo_event = ODP_EVENT_INVALID;
+
+	odp_ticketlock_unlock(&timer->lock);
+
+	return event;
+}
+
 int odp_timer_capability(odp_timer_clk_src_t clk_src,
 			 odp_timer_capability_t *capa)
 {
@@ -706,10 +918,6 @@ odp_timer_pool_t odp_timer_pool_create(const char *name,
 	}
 	timer_global->num_timer_pools++;
 
-	/* Enable inline timer polling */
-	if (timer_global->num_timer_pools == 1)
-		odp_global_rw->inline_timers = true;
-
 	/* Increase poll rate to match the highest resolution */
 	if (timer_global->poll_interval_nsec > nsec_per_scan) {
 		timer_global->poll_interval_nsec = nsec_per_scan;
@@ -749,6 +957,18 @@ odp_timer_pool_t odp_timer_pool_create(const char *name,
 				      timer_pool->free_timer.ring_mask, i);
 	}
 
+	odp_ticketlock_lock(&timer_global->lock);
+
+	/* Timers of pools without an event timer adapter are run by inline
+	 * polling */
+	timer_pool->adapter = NULL;
+	if (timer_adapter_create(timer_pool))
+		timer_global->num_inline_pools++;
+
+	inline_timers_update();
+
+	odp_ticketlock_unlock(&timer_global->lock);
+
 	return timer_pool_to_hdl(timer_pool);
 }
 
@@ -779,9 +999,12 @@ void odp_timer_pool_destroy(odp_timer_pool_t tp)
 	timer_pool->used = 0;
 	timer_global->num_timer_pools--;
 
-	/* Disable inline timer polling */
-	if (timer_global->num_timer_pools == 0)
-		odp_global_rw->inline_timers = false;
+	if (timer_pool->adapter)
+		timer_adapter_destroy(timer_pool);
+	else
+		timer_global->num_inline_pools--;
+
+	inline_timers_update();
 
 	odp_ticketlock_unlock(&timer_global->lock);
 }
@@ -881,6 +1104,23 @@ odp_timer_t odp_timer_alloc(odp_timer_pool_t tp,
 	timer->user_ptr  = user_ptr;
 	timer->queue     = queue;
 	timer->tmo_event = ODP_EVENT_INVALID;
+	timer->use_adapter = 0;
+
+	if (timer_pool->adapter) {
+		/* Event timer adapter delivers timeouts only to scheduled
+		 * queues. Other timers of the pool are run by inline polling. */
+		if (odp_queue_type(queue) == ODP_QUEUE_TYPE_SCHED) {
+			timer_adapter_timer_init(timer, queue);
+		} else {
+			rte_timer_init(&timer->rte_timer);
+			timer->rte_timer.arg = timer;
+
+			odp_ticketlock_lock(&timer_global->lock);
+			timer_global->num_inline_timers++;
+			inline_timers_update();
+			odp_ticketlock_unlock(&timer_global->lock);
+		}
+	}
 
 	/* Add timer to queue */
 	_odp_queue_fn->timer_add(queue);
@@ -916,6 +1156,13 @@ int odp_timer_free(odp_timer_t timer_hdl)
 
 	odp_ticketlock_unlock(&timer->lock);
 
+	if (timer_pool->adapter && !timer->use_adapter) {
+		odp_ticketlock_lock(&timer_global->lock);
+		timer_global->num_inline_timers--;
+		inline_timers_update();
+		odp_ticketlock_unlock(&timer_global->lock);
+	}
+
 	odp_ticketlock_lock(&timer_pool->lock);
 
 	timer_pool->cur_timers--;
@@ -980,8 +1227,15 @@ retry:
 		}
 	}
 
-	if (odp_unlikely(timer_global->ops.reset(&timer->rte_timer, rel_tick,
-						 SINGLE, lcore, timer_cb, timer))) {
+	if (timer->use_adapter) {
+		if (odp_unlikely(timer_adapter_arm(timer, rel_tick))) {
+			odp_ticketlock_unlock(&timer->lock);
+			/* Timer has already expired, or timeout is out of
+			 * the adapter range */
+			return ODP_TIMER_FAIL;
+		}
+	} else if (odp_unlikely(timer_global->ops.reset(&timer->rte_timer, rel_tick,
+							SINGLE, lcore, timer_cb, timer))) {
 		int do_retry = 0;
 
 		/* Another core is currently running the callback function.
@@ -1176,8 +1430,9 @@ int odp_timer_cancel(odp_timer_t timer_hdl, odp_event_t *tmo_ev)
 		return ODP_TIMER_FAIL;
 	}
 
-	if (odp_unlikely(timer_global->ops.stop(&timer->rte_timer))) {
-		/* Another core runs timer callback function. */
+	if (odp_unlikely(timer_entry_stop(timer))) {
+		/* Another core runs timer callback function, or expiration
+		 * event is in flight. */
 		odp_ticketlock_unlock(&timer->lock);
 		return ODP_TIMER_TOO_NEAR;
 	}
@@ -1213,7 +1468,7 @@ int odp_timer_periodic_cancel(odp_timer_t timer_hdl)
 
 	odp_ticketlock_lock(&timer->lock);
 
-	ret = timer_global->ops.stop(&timer->rte_timer);
+	ret = timer_entry_stop(timer);
 
 	/* Mark timer cancelled, so that a following ack call stops restarting it. */
 	timer->periodic_ticks = PERIODIC_CANCELLED;
@@ -7,6 +7,8 @@
 
 #include <odp/api/crypto.h>
 
+#include <odp_global_data.h>
+
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -16,6 +18,17 @@ extern "C" {
 void _odp_crypto_session_print(const char *type, uint32_t index,
 			       const odp_crypto_session_param_t *param);
 
+/* Deliver completions of asynchronously processed crypto operations. Returns
+ * the number of completed operations. */
+int _odp_crypto_compl_poll(void);
+
+/* Static inline wrapper to minimize modification of schedulers. */
+static inline void crypto_compl_poll(void)
+{
+	if (odp_global_rw->crypto_compl_poll)
+		(void)_odp_crypto_compl_poll();
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -190,6 +190,9 @@ void _odp_event_free_multi(_odp_event_hdr_t *event_hdr[], int num_free);
 void _odp_event_free_sp(_odp_event_hdr_t *event_hdr[], int num);
 int _odp_event_is_valid(odp_event_t event);
 
+/* Move events from the local cache of the calling thread back to the pool */
+void _odp_pool_local_cache_flush(pool_t *pool);
+
 static inline void _odp_event_free(odp_event_t event)
 {
 	_odp_event_free_sp((_odp_event_hdr_t **)&event, 1);
@@ -33,6 +33,9 @@ extern "C" {
 #define QUEUE_STATUS_NOTSCHED     3
 #define QUEUE_STATUS_SCHED        4
 
+/* Maximum number of flow queues per atomic queue in flow aware mode */
+#define MAX_FLOW_QUEUES 16
+
 typedef struct ODP_ALIGNED_CACHE queue_entry_s {
 	/* The first cache line is read only */
 	queue_enq_fn_t       enqueue ODP_ALIGNED_CACHE;
@@ -64,6 +67,13 @@ typedef struct ODP_ALIGNED_CACHE queue_entry_s {
 	void             *queue_lf;
 	int               spsc;
 	char              name[ODP_QUEUE_NAME_LEN];
+
+	/* Flow aware atomic queue: events are enqueued into flow queues */
+	uint32_t          num_flow_queue;
+	odp_queue_t       flow_queue[MAX_FLOW_QUEUES];
+
+	/* Flow queue: the application visible queue */
+	odp_queue_t       flow_parent;
 } queue_entry_t;
 
 typedef struct queue_global_t {
@@ -78,6 +88,7 @@ typedef struct queue_global_t {
 	struct {
 		uint32_t max_queue_size;
 		uint32_t default_queue_size;
+		int sched_queue_lockfree;
 	} config;
 
 } queue_global_t;
@@ -37,6 +37,10 @@ typedef struct schedule_config_t {
 	int max_prio;
 	int def_prio;
 
+	/* Number of flow queues per atomic queue in flow aware mode. Zero when
+	 * atomicity is maintained per queue. */
+	uint32_t num_flow_queues;
+
 } schedule_config_t;
 
 typedef void (*schedule_pktio_start_fn_t)(int pktio_index,
@@ -734,6 +734,12 @@ int _odp_crypto_term_local(void)
 	return 0;
 }
 
+int _odp_crypto_compl_poll(void)
+{
+	/* Crypto operations are always completed synchronously */
+	return 0;
+}
+
 void odp_crypto_session_param_init(odp_crypto_session_param_t *param)
 {
 	memset(param, 0, sizeof(odp_crypto_session_param_t));
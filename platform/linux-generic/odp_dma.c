@@ -2,8 +2,11 @@
  * Copyright (c) 2021-2025 Nokia
  */
 
+#include <odp/api/atomic.h>
+#include <odp/api/cpumask.h>
 #include <odp/api/dma.h>
 #include <odp/api/event.h>
+#include <odp/api/init.h>
 #include <odp/api/shared_memory.h>
 #include <odp/api/ticketlock.h>
 #include <odp/api/align.h>
@@ -20,18 +23,33 @@
 #include <odp_debug_internal.h>
 #include <odp_init_internal.h>
 #include <odp_event_internal.h>
+#include <odp_libconfig_internal.h>
+#include <odp_macros_internal.h>
 #include <odp_pool_internal.h>
+#include <odp_ring_mpmc_u32_internal.h>
 #include <odp_string_internal.h>
 
+#include <pthread.h>
+#include <sched.h>
 #include <string.h>
 #include <inttypes.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #define MAX_SESSIONS  CONFIG_MAX_DMA_SESSIONS
 #define MAX_TRANSFERS 256
 #define MAX_SEGS      16
 #define MAX_SEG_LEN   (128 * 1024)
 
+/* Software DMA service */
+#define MAX_SERVICE_THREADS 16
+#define SERVICE_BURST       8
+#define RING_MASK           (MAX_TRANSFERS - 1)
+
 ODP_STATIC_ASSERT(MAX_TRANSFERS < UINT32_MAX, "Too many inflight transfers");
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(MAX_TRANSFERS), "MAX_TRANSFERS must be a power of two");
 
 typedef struct segment_t {
 	void     *addr;
@@ -54,10 +72,48 @@ typedef struct result_t {
 
 } result_t;
 
+/* Transfer queued to service threads */
+typedef struct desc_t {
+	transfer_t trs[2 * MAX_SEGS];
+	/* Source packets to be freed after the copy */
+	odp_packet_t free_pkt[MAX_SEGS];
+	odp_event_t event;
+	odp_queue_t queue;
+	uint32_t num_trs;
+	uint32_t num_free;
+	uint32_t transfer_id;
+	odp_dma_compl_mode_t compl_mode;
+
+} desc_t;
+
+/* Per session service queue */
+typedef struct ODP_ALIGNED_CACHE service_queue_t {
+	/* Started transfers */
+	ring_mpmc_u32_t desc_ring;
+	/* Free descriptors */
+	ring_mpmc_u32_t free_ring;
+	odp_atomic_u32_t enabled;
+	uint32_t desc_ring_data[MAX_TRANSFERS];
+	uint32_t free_ring_data[MAX_TRANSFERS];
+	/* Completion status of poll mode transfers, indexed with transfer ID */
+	odp_atomic_u32_t done[MAX_TRANSFERS];
+	desc_t desc[MAX_TRANSFERS];
+
+} service_queue_t;
+
+typedef enum {
+	SERVICE_IDLE = 0,
+	SERVICE_RUNNING,
+	SERVICE_FAILED
+
+} service_state_t;
+
 typedef struct ODP_ALIGNED_CACHE dma_session_t {
 	odp_ticketlock_t  lock;
 	odp_dma_param_t   dma_param;
 	uint8_t           active;
+	/* Asynchronous transfers are queued to service threads */
+	uint8_t           async;
 	char              name[ODP_DMA_NAME_LEN];
 	odp_stash_t       stash;
 	/* Last element in array reserved for sync transfers, others added to ID stash */
@@ -74,6 +130,24 @@ typedef struct dma_global_t {
 
 	dma_session_t session[MAX_SESSIONS];
 
+	struct {
+		odp_ticketlock_t lock;
+		odp_shm_t shm;
+		/* Service queue per session */
+		service_queue_t *queue;
+		pthread_t thread[MAX_SERVICE_THREADS];
+		odp_atomic_u32_t num_ready;
+		odp_atomic_u32_t num_failed;
+		odp_atomic_u32_t exit;
+		uint32_t num_threads;
+		uint32_t num_created;
+		uint32_t num_sessions;
+		uint32_t async_min_len;
+		uint32_t nt_copy_min_len;
+		service_state_t state;
+
+	} service;
+
 } dma_global_t;
 
 static dma_global_t *_odp_dma_glb;
@@ -83,6 +157,14 @@ static inline dma_session_t *dma_session_from_handle(odp_dma_t dma)
 	return (dma_session_t *)(uintptr_t)dma;
 }
 
+static inline uint32_t index_from_transfer_id(odp_dma_transfer_id_t transfer_id)
+{
+	return transfer_id - 1;
+}
+
+static int service_enable(dma_session_t *session);
+static void service_disable(dma_session_t *session);
+
 int odp_dma_capability(odp_dma_capability_t *capa)
 {
 	if (odp_global_ro.disable.dma) {
@@ -272,6 +354,16 @@ odp_dma_t odp_dma_create(const char *name, const odp_dma_param_t *param)
 		_odp_strcpy(session->name, name, ODP_DMA_NAME_LEN);
 
 	session->dma_param = *param;
+	session->async = 0;
+
+	/* Ordered sessions execute transfers in the calling thread */
+	if (_odp_dma_glb->service.num_threads && param->order == ODP_DMA_ORDER_NONE &&
+	    (param->compl_mode_mask & ~ODP_DMA_COMPL_SYNC)) {
+		if (service_enable(session) == 0)
+			session->async = 1;
+		else
+			_ODP_ERR("DMA service not available, transfers are done synchronously\n");
+	}
 
 	return (odp_dma_t)session;
 }
@@ -286,6 +378,11 @@ int odp_dma_destroy(odp_dma_t dma)
 		return -1;
 	}
 
+	if (session->async) {
+		service_disable(session);
+		session->async = 0;
+	}
+
 	if (session->stash != ODP_STASH_INVALID)
 		if (destroy_stash(session->stash))
 			ret = -1;
@@ -332,7 +429,7 @@ odp_dma_t odp_dma_lookup(const char *name)
 
 static inline result_t *get_sync_res(dma_session_t *session)
 {
-	return &session->result[MAX_SESSIONS];
+	return &session->result[MAX_TRANSFERS];
 }
 
 static uint32_t transfer_len(const odp_dma_transfer_param_t *trs_param)
@@ -538,32 +635,96 @@ static uint32_t add_to_free_set(odp_packet_t pkt, odp_packet_t set[], uint32_t n
 	return num;
 }
 
-static void free_src_segs(const odp_dma_transfer_param_t *transfer)
+static uint32_t src_free_set(const odp_dma_transfer_param_t *transfer, odp_packet_t free_set[])
 {
 	const uint32_t num_src = transfer->num_src;
+	uint32_t num = 0;
 
 	if (transfer->opts.unique_src_segs) {
 		for (uint32_t i = 0; i < num_src; i++)
-			odp_packet_free(transfer->src_seg[i].packet);
-	} else {
-		odp_packet_t free_set[num_src];
-		uint32_t num = 0;
+			free_set[i] = transfer->src_seg[i].packet;
 
-		for (uint32_t i = 0; i < num_src; i++)
-			num = add_to_free_set(transfer->src_seg[i].packet, free_set, num);
+		return num_src;
+	}
+
+	for (uint32_t i = 0; i < num_src; i++)
+		num = add_to_free_set(transfer->src_seg[i].packet, free_set, num);
+
+	return num;
+}
+
+static void free_src_segs(const odp_dma_transfer_param_t *transfer)
+{
+	odp_packet_t free_set[transfer->num_src];
+	uint32_t num = src_free_set(transfer, free_set);
+
+	odp_packet_free_multi(free_set, num);
+}
 
-		odp_packet_free_multi(free_set, num);
+#ifdef __SSE2__
+/* Copy with non-temporal stores, which bypass caches on the destination side. Caller must
+ * issue a store fence before publishing the data to other threads. */
+static void nt_copy(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+	uint32_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+
+	memcpy(dst, src, head);
+	dst += head;
+	src += head;
+	len -= head;
+
+	while (len >= 64) {
+		__m128i a = _mm_loadu_si128((const __m128i *)(uintptr_t)src);
+		__m128i b = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 16));
+		__m128i c = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 32));
+		__m128i d = _mm_loadu_si128((const __m128i *)(uintptr_t)(src + 48));
+
+		_mm_stream_si128((__m128i *)(uintptr_t)dst, a);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 16), b);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 32), c);
+		_mm_stream_si128((__m128i *)(uintptr_t)(dst + 48), d);
+		dst += 64;
+		src += 64;
+		len -= 64;
 	}
+
+	memcpy(dst, src, len);
 }
+#endif
 
-static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
-		       result_t *result)
+static inline void copy_data(const transfer_t trs[], uint32_t num, uint32_t nt_copy_min_len)
+{
+#ifdef __SSE2__
+	odp_bool_t nt_used = false;
+
+	for (uint32_t i = 0; i < num; i++) {
+		if (nt_copy_min_len && trs[i].len >= nt_copy_min_len) {
+			nt_copy(trs[i].dst, trs[i].src, trs[i].len);
+			nt_used = true;
+		} else {
+			memcpy(trs[i].dst, trs[i].src, trs[i].len);
+		}
+	}
+
+	if (nt_used)
+		_mm_sfence();
+#else
+	(void)nt_copy_min_len;
+
+	for (uint32_t i = 0; i < num; i++)
+		memcpy(trs[i].dst, trs[i].src, trs[i].len);
+#endif
+}
+
+/* Check transfer parameters and fill in transfer table. Returns number of table entries or
+ * -1 on failure. */
+static int prepare_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+			    result_t *result, transfer_t trs[])
 {
-	int num, i;
+	int num;
 	uint32_t tot_len;
 	int num_src, num_dst;
 	const int max_num = 2 * MAX_SEGS;
-	transfer_t trs[max_num];
 	segment_t src[MAX_SEGS];
 	segment_t dst[MAX_SEGS];
 
@@ -633,8 +794,21 @@ static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *t
 		return -1;
 	}
 
-	for (i = 0; i < num; i++)
-		memcpy(trs[i].dst, trs[i].src, trs[i].len);
+	return num;
+}
+
+static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+		       result_t *result)
+{
+	transfer_t trs[2 * MAX_SEGS];
+	int num;
+
+	num = prepare_transfer(session, transfer, result, trs);
+
+	if (odp_unlikely(num < 0))
+		return -1;
+
+	copy_data(trs, num, 0);
 
 	if (transfer->opts.seg_free)
 		free_src_segs(transfer);
@@ -642,6 +816,255 @@ static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *t
 	return 1;
 }
 
+static inline service_queue_t *service_queue(dma_session_t *session)
+{
+	return &_odp_dma_glb->service.queue[session - _odp_dma_glb->session];
+}
+
+/* Free packets directly to their pools. Freed packets must be available to other threads
+ * once the completion has been posted. */
+static void free_pkts(odp_packet_t pkt[], uint32_t num)
+{
+	odp_pool_t pool[num];
+	uint32_t num_pool = 0, i, j;
+
+	for (i = 0; i < num; i++) {
+		odp_pool_t cur = odp_packet_pool(pkt[i]);
+
+		for (j = 0; j < num_pool; j++)
+			if (pool[j] == cur)
+				break;
+
+		if (j == num_pool)
+			pool[num_pool++] = cur;
+	}
+
+	odp_packet_free_multi(pkt, num);
+
+	for (i = 0; i < num_pool; i++)
+		_odp_pool_local_cache_flush(_odp_pool_entry(pool[i]));
+}
+
+static void service_desc_run(service_queue_t *queue, uint32_t idx)
+{
+	desc_t *desc = &queue->desc[idx];
+	const odp_dma_compl_mode_t compl_mode = desc->compl_mode;
+	const odp_event_t event = desc->event;
+	const odp_queue_t compl_queue = desc->queue;
+	const uint32_t transfer_id = desc->transfer_id;
+
+	copy_data(desc->trs, desc->num_trs, _odp_dma_glb->service.nt_copy_min_len);
+
+	if (desc->num_free)
+		free_pkts(desc->free_pkt, desc->num_free);
+
+	/* Descriptor is released before completion, so that the session may be destroyed
+	 * as soon as the application has seen all completions */
+	ring_mpmc_u32_enq(&queue->free_ring, queue->free_ring_data, RING_MASK, idx);
+
+	if (compl_mode == ODP_DMA_COMPL_EVENT) {
+		if (odp_unlikely(odp_queue_enq(compl_queue, event)))
+			_ODP_ERR("Completion event enqueue failed %" PRIu64 "\n",
+				 odp_queue_to_u64(compl_queue));
+	} else if (compl_mode == ODP_DMA_COMPL_POLL) {
+		odp_atomic_store_rel_u32(&queue->done[index_from_transfer_id(transfer_id)], 1);
+	}
+}
+
+static void *service_thread(void *arg)
+{
+	const uint32_t first = (uint32_t)(uintptr_t)arg;
+	service_queue_t *queue;
+	uint32_t idx[SERVICE_BURST];
+	uint32_t i, j, num, tot;
+
+	if (odp_init_local((odp_instance_t)odp_global_ro.main_pid, ODP_THREAD_CONTROL)) {
+		_ODP_ERR("DMA service thread local init failed\n");
+		odp_atomic_inc_u32(&_odp_dma_glb->service.num_failed);
+		return NULL;
+	}
+
+	odp_atomic_inc_u32(&_odp_dma_glb->service.num_ready);
+
+	while (odp_atomic_load_acq_u32(&_odp_dma_glb->service.exit) == 0) {
+		tot = 0;
+
+		/* Threads start from different sessions to spread the load */
+		for (i = 0; i < MAX_SESSIONS; i++) {
+			queue = &_odp_dma_glb->service.queue[(first + i) % MAX_SESSIONS];
+
+			if (odp_atomic_load_acq_u32(&queue->enabled) == 0)
+				continue;
+
+			num = ring_mpmc_u32_deq_multi(&queue->desc_ring, queue->desc_ring_data,
+						      RING_MASK, idx, SERVICE_BURST);
+
+			for (j = 0; j < num; j++)
+				service_desc_run(queue, idx[j]);
+
+			tot += num;
+		}
+
+		if (tot == 0)
+			odp_cpu_pause();
+	}
+
+	if (odp_term_local() < 0)
+		_ODP_ERR("DMA service thread local term failed\n");
+
+	return NULL;
+}
+
+static void service_threads_stop(void)
+{
+	odp_atomic_store_rel_u32(&_odp_dma_glb->service.exit, 1);
+
+	for (uint32_t i = 0; i < _odp_dma_glb->service.num_created; i++)
+		(void)pthread_join(_odp_dma_glb->service.thread[i], NULL);
+
+	_odp_dma_glb->service.num_created = 0;
+	odp_atomic_store_u32(&_odp_dma_glb->service.num_ready, 0);
+	odp_atomic_store_u32(&_odp_dma_glb->service.num_failed, 0);
+	odp_atomic_store_u32(&_odp_dma_glb->service.exit, 0);
+}
+
+static int service_threads_start(void)
+{
+	const uint32_t num_threads = _odp_dma_glb->service.num_threads;
+	odp_cpumask_t mask;
+	cpu_set_t cpu_set;
+	pthread_attr_t attr;
+	int cpu, ret;
+
+	odp_cpumask_default_control(&mask, 0);
+	cpu = odp_cpumask_first(&mask);
+
+	for (uint32_t i = 0; i < num_threads; i++) {
+		/* Pin threads round-robin to control CPUs */
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpu, &cpu_set);
+		pthread_attr_init(&attr);
+		pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpu_set);
+		ret = pthread_create(&_odp_dma_glb->service.thread[i], &attr, service_thread,
+				     (void *)(uintptr_t)i);
+		pthread_attr_destroy(&attr);
+
+		if (ret) {
+			_ODP_ERR("Failed to start DMA service thread on CPU #%i: %i\n", cpu, ret);
+			break;
+		}
+
+		_odp_dma_glb->service.num_created++;
+		cpu = odp_cpumask_next(&mask, cpu);
+
+		if (cpu < 0)
+			cpu = odp_cpumask_first(&mask);
+	}
+
+	while (odp_atomic_load_u32(&_odp_dma_glb->service.num_ready) +
+	       odp_atomic_load_u32(&_odp_dma_glb->service.num_failed) <
+	       _odp_dma_glb->service.num_created)
+		odp_cpu_pause();
+
+	if (_odp_dma_glb->service.num_created < num_threads ||
+	    odp_atomic_load_u32(&_odp_dma_glb->service.num_failed)) {
+		service_threads_stop();
+		return -1;
+	}
+
+	_ODP_DBG("Started %u DMA service threads\n", num_threads);
+
+	return 0;
+}
+
+static int service_enable(dma_session_t *session)
+{
+	service_queue_t *queue;
+	service_state_t state;
+
+	odp_ticketlock_lock(&_odp_dma_glb->service.lock);
+
+	if (_odp_dma_glb->service.state == SERVICE_IDLE)
+		_odp_dma_glb->service.state = service_threads_start() ? SERVICE_FAILED :
+									 SERVICE_RUNNING;
+
+	state = _odp_dma_glb->service.state;
+
+	if (state == SERVICE_RUNNING)
+		_odp_dma_glb->service.num_sessions++;
+
+	odp_ticketlock_unlock(&_odp_dma_glb->service.lock);
+
+	if (state != SERVICE_RUNNING)
+		return -1;
+
+	queue = service_queue(session);
+	ring_mpmc_u32_init(&queue->desc_ring);
+	ring_mpmc_u32_init(&queue->free_ring);
+
+	for (uint32_t i = 0; i < MAX_TRANSFERS; i++) {
+		ring_mpmc_u32_enq(&queue->free_ring, queue->free_ring_data, RING_MASK, i);
+		odp_atomic_init_u32(&queue->done[i], 1);
+	}
+
+	odp_atomic_store_rel_u32(&queue->enabled, 1);
+
+	return 0;
+}
+
+static void service_disable(dma_session_t *session)
+{
+	odp_atomic_store_rel_u32(&service_queue(session)->enabled, 0);
+
+	/* Threads are stopped with the last session, so that they do not remain as active ODP
+	 * threads when the application terminates */
+	odp_ticketlock_lock(&_odp_dma_glb->service.lock);
+
+	if (--_odp_dma_glb->service.num_sessions == 0) {
+		service_threads_stop();
+		_odp_dma_glb->service.state = SERVICE_IDLE;
+	}
+
+	odp_ticketlock_unlock(&_odp_dma_glb->service.lock);
+}
+
+static int service_transfer_start(dma_session_t *session,
+				  const odp_dma_transfer_param_t *transfer,
+				  const odp_dma_compl_param_t *compl, result_t *res)
+{
+	service_queue_t *queue = service_queue(session);
+	desc_t *desc;
+	uint32_t idx;
+	int num;
+
+	if (odp_unlikely(ring_mpmc_u32_deq(&queue->free_ring, queue->free_ring_data, RING_MASK,
+					   &idx) == 0))
+		return 0;
+
+	desc = &queue->desc[idx];
+	num = prepare_transfer(session, transfer, res, desc->trs);
+
+	if (odp_unlikely(num < 0)) {
+		ring_mpmc_u32_enq(&queue->free_ring, queue->free_ring_data, RING_MASK, idx);
+		return -1;
+	}
+
+	desc->num_trs = num;
+	desc->num_free = transfer->opts.seg_free ? src_free_set(transfer, desc->free_pkt) : 0;
+	desc->compl_mode = compl->compl_mode;
+	desc->event = compl->event;
+	desc->queue = compl->queue;
+	desc->transfer_id = compl->transfer_id;
+
+	if (compl->compl_mode == ODP_DMA_COMPL_POLL)
+		odp_atomic_store_u32(&queue->done[index_from_transfer_id(compl->transfer_id)], 0);
+
+	/* Ring has room for all descriptors */
+	ring_mpmc_u32_enq(&queue->desc_ring, queue->desc_ring_data, RING_MASK, idx);
+
+	return 1;
+}
+
 int odp_dma_transfer(odp_dma_t dma, const odp_dma_transfer_param_t *transfer,
 		     odp_dma_result_t *result)
 {
@@ -745,11 +1168,6 @@ void odp_dma_transfer_id_free(odp_dma_t dma, odp_dma_transfer_id_t transfer_id)
 		_ODP_ERR("Stash put failed\n");
 }
 
-static inline uint32_t index_from_transfer_id(odp_dma_transfer_id_t transfer_id)
-{
-	return transfer_id - 1;
-}
-
 int odp_dma_transfer_start(odp_dma_t dma, const odp_dma_transfer_param_t *transfer,
 			   const odp_dma_compl_param_t *compl)
 {
@@ -798,6 +1216,10 @@ int odp_dma_transfer_start(odp_dma_t dma, const odp_dma_transfer_param_t *transf
 		return -1;
 	}
 
+	if (session->async && transfer_len(transfer) >= _odp_dma_glb->service.async_min_len)
+		return service_transfer_start(session, transfer, compl,
+					      transfer->opts.seg_alloc ? res : NULL);
+
 	ret = do_transfer(session, transfer, transfer->opts.seg_alloc ? res : NULL);
 
 	if (odp_unlikely(ret < 1))
@@ -857,6 +1279,10 @@ int odp_dma_transfer_done(odp_dma_t dma, odp_dma_transfer_id_t transfer_id,
 		return -1;
 	}
 
+	if (session->async &&
+	    odp_atomic_load_acq_u32(&service_queue(session)->done[index_from_transfer_id(id)]) == 0)
+		return 0;
+
 	if (result) {
 		result_t *res = &session->result[index_from_transfer_id(id)];
 
@@ -1017,6 +1443,95 @@ void odp_dma_compl_print(odp_dma_compl_t dma_compl)
 	_ODP_PRINT("\n");
 }
 
+static int read_config_file(dma_global_t *global)
+{
+	const char *str;
+	int val = 0;
+
+	_ODP_PRINT("DMA config:\n");
+
+	str = "dma.num_threads";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > MAX_SERVICE_THREADS) {
+		_ODP_ERR("Bad config option '%s' value: %i\n", str, val);
+		return -1;
+	}
+
+	global->service.num_threads = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "dma.async_min_len";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0) {
+		_ODP_ERR("Bad config option '%s' value: %i\n", str, val);
+		return -1;
+	}
+
+	global->service.async_min_len = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "dma.nt_copy_min_len";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0) {
+		_ODP_ERR("Bad config option '%s' value: %i\n", str, val);
+		return -1;
+	}
+
+	global->service.nt_copy_min_len = val;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
+
+	if (global->service.num_threads &&
+	    odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS) {
+		_ODP_PRINT("DMA service threads not supported in process mode, disabled\n");
+		global->service.num_threads = 0;
+	}
+
+	return 0;
+}
+
+static int service_init(dma_global_t *global)
+{
+	odp_shm_t shm;
+
+	odp_ticketlock_init(&global->service.lock);
+	odp_atomic_init_u32(&global->service.num_ready, 0);
+	odp_atomic_init_u32(&global->service.num_failed, 0);
+	odp_atomic_init_u32(&global->service.exit, 0);
+	global->service.shm = ODP_SHM_INVALID;
+	global->service.state = SERVICE_IDLE;
+
+	if (global->service.num_threads == 0)
+		return 0;
+
+	shm = odp_shm_reserve("_odp_dma_service", sizeof(service_queue_t) * MAX_SESSIONS,
+			      ODP_CACHE_LINE_SIZE, 0);
+	global->service.queue = odp_shm_addr(shm);
+
+	if (global->service.queue == NULL) {
+		_ODP_ERR("SHM reserve failed\n");
+		return -1;
+	}
+
+	global->service.shm = shm;
+
+	for (int i = 0; i < MAX_SESSIONS; i++)
+		odp_atomic_init_u32(&global->service.queue[i].enabled, 0);
+
+	return 0;
+}
+
 int _odp_dma_init_global(void)
 {
 	odp_shm_t shm;
@@ -1048,6 +1563,12 @@ int _odp_dma_init_global(void)
 	for (i = 0; i < MAX_SESSIONS; i++)
 		odp_ticketlock_init(&_odp_dma_glb->session[i].lock);
 
+	if (read_config_file(_odp_dma_glb) || service_init(_odp_dma_glb)) {
+		(void)odp_shm_free(shm);
+		_odp_dma_glb = NULL;
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -1061,6 +1582,15 @@ int _odp_dma_term_global(void)
 	if (_odp_dma_glb == NULL)
 		return 0;
 
+	if (_odp_dma_glb->service.state == SERVICE_RUNNING)
+		service_threads_stop();
+
+	if (_odp_dma_glb->service.shm != ODP_SHM_INVALID &&
+	    odp_shm_free(_odp_dma_glb->service.shm)) {
+		_ODP_ERR("SHM free failed\n");
+		return -1;
+	}
+
 	shm = _odp_dma_glb->shm;
 
 	if (odp_shm_free(shm)) {
@@ -6,12 +6,16 @@
 #include <odp/api/byteorder.h>
 #include <odp/api/ipsec.h>
 #include <odp/api/chksum.h>
+#include <odp/api/event.h>
+#include <odp/api/packet.h>
+#include <odp/api/pool.h>
 
 #include <odp/api/plat/byteorder_inlines.h>
 #include <odp/api/plat/ipsec_inlines.h>
 #include <odp/api/plat/packet_inlines.h>
 #include <odp/api/plat/queue_inlines.h>
 
+#include <odp_config_internal.h>
 #include <odp_global_data.h>
 #include <odp_init_internal.h>
 #include <odp_debug_internal.h>
@@ -28,6 +32,7 @@
 #include <protocols/udp.h>
 
 #include <errno.h>
+#include <inttypes.h>
 #include <string.h>
 
 typedef enum {
@@ -184,6 +189,14 @@ int odp_ipsec_capability(odp_ipsec_capability_t *capa)
 	capa->reass_async = false;
 	capa->reass_inline = false;
 
+	/* Packet vectors are formed from the result packets of a single enqueue
+	 * call, so no vector timeout is needed */
+	capa->vector.supported = ODP_SUPPORT_YES;
+	capa->vector.max_size = CONFIG_PACKET_VECTOR_MAX_SIZE;
+	capa->vector.min_size = 1;
+	capa->vector.max_tmo_ns = 0;
+	capa->vector.min_tmo_ns = 0;
+
 	return 0;
 }
 
@@ -294,11 +307,46 @@ void odp_ipsec_config_init(odp_ipsec_config_t *config)
 	config->stats_en = false;
 }
 
+static int check_vector_config(const odp_pktin_vector_config_t *vector)
+{
+	odp_pool_info_t pool_info;
+
+	if (vector->max_size < 1 || vector->max_size > CONFIG_PACKET_VECTOR_MAX_SIZE) {
+		_ODP_ERR("Bad vector.max_size %" PRIu32 "\n", vector->max_size);
+		return -1;
+	}
+
+	if (vector->max_tmo_ns) {
+		_ODP_ERR("vector.max_tmo_ns too large %" PRIu64 "\n", vector->max_tmo_ns);
+		return -1;
+	}
+
+	if (vector->pool == ODP_POOL_INVALID || odp_pool_info(vector->pool, &pool_info)) {
+		_ODP_ERR("Invalid packet vector pool\n");
+		return -1;
+	}
+
+	if (pool_info.params.type != ODP_POOL_VECTOR) {
+		_ODP_ERR("Wrong vector pool type\n");
+		return -1;
+	}
+
+	if (vector->max_size > pool_info.params.vector.max_size) {
+		_ODP_ERR("vector.max_size larger than pool max vector size\n");
+		return -1;
+	}
+
+	return 0;
+}
+
 int odp_ipsec_config(const odp_ipsec_config_t *config)
 {
 	if (config->max_num_sa > _odp_ipsec_max_num_sa())
 		return -1;
 
+	if (config->vector.enable && check_vector_config(&config->vector))
+		return -1;
+
 	*ipsec_config = *config;
 
 	return 0;
@@ -2129,16 +2177,94 @@ static inline void finish_packet_proc(odp_packet_t pkt, ipsec_op_t *op, odp_queu
 	if (op->sa_hdl == ODP_IPSEC_SA_INVALID && op->sa)
 		_odp_ipsec_sa_unuse(op->sa);
 
-	if (queue != ODP_QUEUE_INVALID) {
+	if (queue != ODP_QUEUE_INVALID)
 		res->orig_ip_len = op->orig_ip_len;
+}
+
+/* Enqueue result events and free the ones that could not be enqueued */
+static inline void result_enq_multi(odp_queue_t queue, odp_event_t ev[], int num)
+{
+	int ret = odp_queue_enq_multi(queue, ev, num);
+
+	if (odp_unlikely(ret < num)) {
+		if (ret < 0)
+			ret = 0;
+
 		/* What should be done if enqueue fails? */
-		if (odp_unlikely(odp_queue_enq(queue, odp_ipsec_packet_to_event(pkt)) < 0))
-			odp_packet_free(pkt);
+		odp_event_free_multi(&ev[ret], num - ret);
+	}
+}
+
+static inline int result_vector_enq(odp_queue_t queue, odp_packet_t pkt[], int num)
+{
+	odp_packet_vector_t pktv;
+	odp_packet_t *pkt_tbl;
+	odp_event_t ev;
+
+	pktv = odp_packet_vector_alloc(ipsec_config->vector.pool);
+	if (odp_unlikely(pktv == ODP_PACKET_VECTOR_INVALID))
+		return -1;
+
+	odp_packet_vector_tbl(pktv, &pkt_tbl);
+	for (int i = 0; i < num; i++)
+		pkt_tbl[i] = pkt[i];
+	odp_packet_vector_size_set(pktv, num);
+
+	ev = odp_packet_vector_to_event(pktv);
+	result_enq_multi(queue, &ev, 1);
+
+	return 0;
+}
+
+/*
+ * Deliver result packets of an enqueue operation to their destination queues.
+ * Consecutive packets with the same destination are enqueued with a single
+ * call, or as packet vectors when vector output has been configured.
+ */
+static void ipsec_result_enq(odp_packet_t pkt[], const odp_queue_t queue[], int num)
+{
+	const odp_bool_t vector_en = ipsec_config->vector.enable;
+	const int max_size = ipsec_config->vector.max_size;
+	odp_event_t ev[MAX_BURST];
+	int i = 0;
+
+	while (i < num) {
+		odp_queue_t q = queue[i];
+		int first = i;
+		int num_run;
+
+		while (i < num && queue[i] == q)
+			i++;
+
+		num_run = i - first;
+
+		if (vector_en) {
+			while (num_run > 1) {
+				int num_vec = _ODP_MIN(num_run, max_size);
+
+				if (odp_unlikely(result_vector_enq(q, &pkt[first], num_vec)))
+					break;
+
+				first += num_vec;
+				num_run -= num_vec;
+			}
+
+			if (num_run == 0)
+				continue;
+		}
+
+		/* Vectors not in use, single packet left over, or vector allocation failed */
+		for (int j = 0; j < num_run; j++)
+			ev[j] = odp_ipsec_packet_to_event(pkt[first + j]);
+
+		result_enq_multi(q, ev, num_run);
 	}
 }
 
 static void ipsec_in_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num, odp_bool_t is_enq)
 {
+	odp_queue_t queue[MAX_BURST];
+
 	for (int i = 0; i < num; i++) {
 		ipsec_op_t *op = &ops[i];
 		odp_packet_t *pkt = &pkt_in[i];
@@ -2168,11 +2294,16 @@ static void ipsec_in_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num,
 		ipsec_in_parse_decap_packet(*pkt, &op->state, op->sa);
 
 finish:
-		if (is_enq)
+		if (is_enq) {
 			q = NULL != op->sa ? op->sa->queue : ipsec_config->inbound.default_queue;
+			queue[i] = q;
+		}
 
 		finish_packet_proc(*pkt, op, q);
 	}
+
+	if (is_enq)
+		ipsec_result_enq(pkt_in, queue, num);
 }
 
 int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in, odp_packet_t pkt_out[], int *num_out,
@@ -2259,6 +2390,8 @@ static int ipsec_out_check_crypto_result(odp_packet_t pkt, odp_ipsec_op_status_t
 
 static void ipsec_out_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num, odp_bool_t is_enq)
 {
+	odp_queue_t queue[MAX_BURST];
+
 	for (int i = 0; i < num; i++) {
 		ipsec_op_t *op = &ops[i];
 		odp_packet_t *pkt = &pkt_in[i];
@@ -2276,11 +2409,16 @@ static void ipsec_out_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num,
 			update_post_lifetime_stats(op->sa, &op->state);
 
 finish:
-		if (is_enq)
+		if (is_enq) {
 			q = NULL != op->sa ? op->sa->queue : ipsec_config->inbound.default_queue;
+			queue[i] = q;
+		}
 
 		finish_packet_proc(*pkt, op, q);
 	}
+
+	if (is_enq)
+		ipsec_result_enq(pkt_in, queue, num);
 }
 
 int odp_ipsec_out(const odp_packet_t pkt_in[], int num_in, odp_packet_t pkt_out[], int *num_out,
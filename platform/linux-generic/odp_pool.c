@@ -425,6 +425,11 @@ int _odp_pool_term_local(void)
 	return 0;
 }
 
+void _odp_pool_local_cache_flush(pool_t *pool)
+{
+	cache_flush(local.cache[pool->pool_idx], pool);
+}
+
 static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num)
 {
 	int i;
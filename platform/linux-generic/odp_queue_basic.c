@@ -45,6 +45,7 @@
 
 static int queue_init(queue_entry_t *queue, const char *name,
 		      const odp_queue_param_t *param);
+static int queue_destroy(odp_queue_t handle);
 
 queue_global_t *_odp_queue_glb;
 extern _odp_queue_inline_offset_t _odp_queue_inline_offset;
@@ -104,7 +105,21 @@ static int read_config_file(queue_global_t *_odp_queue_glb)
 	}
 
 	_odp_queue_glb->config.default_queue_size = val_u32;
-	_ODP_PRINT("  %s: %u\n\n", str, val_u32);
+	_ODP_PRINT("  %s: %u\n", str, val_u32);
+
+	str = "queue_basic.sched_queue_lockfree";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > 1 || val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	_odp_queue_glb->config.sched_queue_lockfree = val;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
 
 	return 0;
 }
@@ -257,8 +272,8 @@ static uint32_t queue_lock_count(odp_queue_t handle)
 		queue->param.sched.lock_count : 0;
 }
 
-static odp_queue_t queue_create(const char *name,
-				const odp_queue_param_t *param)
+static odp_queue_t queue_alloc(const char *name, const odp_queue_param_t *param,
+			       odp_queue_t flow_parent)
 {
 	uint32_t i;
 	uint32_t max_idx;
@@ -325,6 +340,8 @@ static odp_queue_t queue_create(const char *name,
 				return ODP_QUEUE_INVALID;
 			}
 
+			queue->flow_parent = flow_parent;
+
 			if (!queue->spsc &&
 			    param->nonblocking == ODP_NONBLOCKING_LF) {
 				queue_lf_func_t *lf_fn;
@@ -373,6 +390,109 @@ static odp_queue_t queue_create(const char *name,
 	return handle;
 }
 
+/* Enqueue into a flow aware atomic queue. Events are passed to flow queues
+ * selected by event flow ID. Consecutive events of the same flow queue are
+ * enqueued with a single call. */
+static int flow_queue_enq_multi(odp_queue_t handle, _odp_event_hdr_t *event_hdr[], int num)
+{
+	queue_entry_t *queue = qentry_from_handle(handle);
+	const uint32_t mask = queue->num_flow_queue - 1;
+	int total = 0;
+	int i = 0;
+
+	while (i < num) {
+		uint32_t fq = event_hdr[i]->flow_id & mask;
+		queue_entry_t *flow_queue = qentry_from_handle(queue->flow_queue[fq]);
+		int burst, num_enq;
+
+		for (burst = 1; i + burst < num; burst++) {
+			if ((event_hdr[i + burst]->flow_id & mask) != fq)
+				break;
+		}
+
+		num_enq = flow_queue->enqueue_multi(flow_queue->handle, &event_hdr[i], burst);
+
+		if (num_enq > 0)
+			total += num_enq;
+
+		if (num_enq < burst)
+			break;
+
+		i += burst;
+	}
+
+	return total;
+}
+
+static int flow_queue_enq(odp_queue_t handle, _odp_event_hdr_t *event_hdr)
+{
+	queue_entry_t *queue = qentry_from_handle(handle);
+	uint32_t fq = event_hdr->flow_id & (queue->num_flow_queue - 1);
+	queue_entry_t *flow_queue = qentry_from_handle(queue->flow_queue[fq]);
+
+	return flow_queue->enqueue(flow_queue->handle, event_hdr);
+}
+
+/* Create flow queues of a flow aware atomic queue */
+static int flow_queue_create(queue_entry_t *queue, const char *name, uint32_t num)
+{
+	char flow_name[ODP_QUEUE_NAME_LEN];
+	uint32_t i;
+
+	for (i = 0; i < num; i++) {
+		snprintf(flow_name, sizeof(flow_name), "%s-flow%u", name ? name : "", i);
+
+		queue->flow_queue[i] = queue_alloc(flow_name, &queue->param, queue->handle);
+		if (queue->flow_queue[i] == ODP_QUEUE_INVALID) {
+			_ODP_ERR("Flow queue create failed\n");
+			break;
+		}
+	}
+
+	if (i < num) {
+		while (i--)
+			queue_destroy(queue->flow_queue[i]);
+
+		return -1;
+	}
+
+	LOCK(queue);
+	queue->num_flow_queue = num;
+	queue->enqueue        = flow_queue_enq;
+	queue->enqueue_multi  = flow_queue_enq_multi;
+	UNLOCK(queue);
+
+	return 0;
+}
+
+static odp_queue_t queue_create(const char *name,
+				const odp_queue_param_t *param)
+{
+	schedule_config_t config;
+	odp_queue_t handle;
+
+	handle = queue_alloc(name, param, ODP_QUEUE_INVALID);
+
+	if (handle == ODP_QUEUE_INVALID)
+		return ODP_QUEUE_INVALID;
+
+	if (qentry_from_handle(handle)->param.type != ODP_QUEUE_TYPE_SCHED ||
+	    qentry_from_handle(handle)->param.sched.sync != ODP_SCHED_SYNC_ATOMIC)
+		return handle;
+
+	/* In flow aware mode, atomicity of an atomic queue is maintained per
+	 * flow queue */
+	_odp_sched_fn->get_config(&config);
+
+	if (config.num_flow_queues &&
+	    flow_queue_create(qentry_from_handle(handle), name, config.num_flow_queues)) {
+		queue_destroy(handle);
+		return ODP_QUEUE_INVALID;
+	}
+
+	return handle;
+}
+
 static int queue_create_multi(const char *name[], const odp_queue_param_t param[],
 			      odp_bool_t share_param, odp_queue_t queue[], int num)
 {
@@ -396,17 +516,66 @@ static int queue_create_multi(const char *name[], const odp_queue_param_t param[
 	return i;
 }
 
+/* Lock-free scheduled queues use the ring_mpmc instead of ring_st */
+static inline int sched_queue_lf(const queue_entry_t *queue)
+{
+	return queue->type == ODP_QUEUE_TYPE_SCHED &&
+	       _odp_queue_glb->config.sched_queue_lockfree;
+}
+
+static inline int queue_status_load(queue_entry_t *queue)
+{
+	return __atomic_load_n(&queue->status, __ATOMIC_ACQUIRE);
+}
+
+static inline int queue_status_cas(queue_entry_t *queue, int *old, int new_status)
+{
+	return __atomic_compare_exchange_n(&queue->status, old, new_status, 0,
+					   __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
 void _odp_sched_queue_set_status(uint32_t queue_index, int status)
 {
 	queue_entry_t *queue = qentry_from_index(queue_index);
 
 	LOCK(queue);
 
-	queue->status = status;
+	__atomic_store_n(&queue->status, status, __ATOMIC_RELEASE);
 
 	UNLOCK(queue);
 }
 
+static int flow_queue_destroy(queue_entry_t *queue)
+{
+	uint32_t i;
+
+	for (i = 0; i < queue->num_flow_queue; i++) {
+		queue_entry_t *flow_queue = qentry_from_handle(queue->flow_queue[i]);
+		int empty;
+
+		LOCK(flow_queue);
+		if (sched_queue_lf(flow_queue))
+			empty = ring_mpmc_ptr_is_empty(&flow_queue->ring_mpmc);
+		else
+			empty = ring_st_ptr_is_empty(&flow_queue->ring_st);
+		UNLOCK(flow_queue);
+
+		if (!empty) {
+			_ODP_ERR("queue \"%s\" not empty\n", queue->name);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < queue->num_flow_queue; i++) {
+		if (queue_destroy(queue->flow_queue[i]))
+			return -1;
+	}
+
+	queue->num_flow_queue = 0;
+
+	return 0;
+}
+
 static int queue_destroy(odp_queue_t handle)
 {
 	int empty;
@@ -417,6 +586,10 @@ static int queue_destroy(odp_queue_t handle)
 	if (handle == ODP_QUEUE_INVALID)
 		return -1;
 
+	if (queue->num_flow_queue && queue->status >= QUEUE_STATUS_READY &&
+	    flow_queue_destroy(queue))
+		return -1;
+
 	LOCK(queue);
 	if (queue->status == QUEUE_STATUS_FREE) {
 		UNLOCK(queue);
@@ -431,7 +604,7 @@ static int queue_destroy(odp_queue_t handle)
 
 	if (queue->spsc)
 		empty = ring_spsc_ptr_is_empty(&queue->ring_spsc);
-	else if (queue->type == ODP_QUEUE_TYPE_SCHED)
+	else if (queue->type == ODP_QUEUE_TYPE_SCHED && !sched_queue_lf(queue))
 		empty = ring_st_ptr_is_empty(&queue->ring_st);
 	else
 		empty = ring_mpmc_ptr_is_empty(&queue->ring_mpmc);
@@ -442,6 +615,28 @@ static int queue_destroy(odp_queue_t handle)
 		return -1;
 	}
 
+	if (sched_queue_lf(queue)) {
+		int status = queue_status_load(queue);
+
+		/* Scheduler may concurrently remove an empty queue from scheduling */
+		while (1) {
+			if (status == QUEUE_STATUS_NOTSCHED) {
+				if (queue_status_cas(queue, &status, QUEUE_STATUS_FREE)) {
+					_odp_sched_fn->destroy_queue(queue->index);
+					break;
+				}
+			} else if (status == QUEUE_STATUS_SCHED) {
+				if (queue_status_cas(queue, &status, QUEUE_STATUS_DESTROYED))
+					break;
+			} else {
+				_ODP_ABORT("Unexpected queue status\n");
+			}
+		}
+
+		UNLOCK(queue);
+		return 0;
+	}
+
 	switch (queue->status) {
 	case QUEUE_STATUS_READY:
 		queue->status = QUEUE_STATUS_FREE;
@@ -751,7 +946,7 @@ static void queue_print(odp_queue_t handle)
 		_ODP_PRINT("  implementation  ring_spsc\n");
 		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
 			   ring_spsc_ptr_len(&queue->ring_spsc), queue->ring_mask + 1);
-	} else if (queue->type == ODP_QUEUE_TYPE_SCHED) {
+	} else if (queue->type == ODP_QUEUE_TYPE_SCHED && !sched_queue_lf(queue)) {
 		_ODP_PRINT("  implementation  ring_st\n");
 		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
 			   ring_st_ptr_len(&queue->ring_st), queue->ring_mask + 1);
@@ -816,7 +1011,10 @@ static void queue_print_all(void)
 			len     = ring_spsc_ptr_len(&queue->ring_spsc);
 			max_len = queue->ring_mask + 1;
 		} else if (type == ODP_QUEUE_TYPE_SCHED) {
-			len     = ring_st_ptr_len(&queue->ring_st);
+			if (sched_queue_lf(queue))
+				len = ring_mpmc_ptr_len(&queue->ring_mpmc);
+			else
+				len = ring_st_ptr_len(&queue->ring_st);
 			max_len = queue->ring_mask + 1;
 			prio    = queue->param.sched.prio;
 			grp     = queue->param.sched.group;
@@ -938,6 +1136,143 @@ static inline int sched_queue_enq_multi(odp_queue_t handle,
 	return num_enq;
 }
 
+/* Add a lock-free queue into scheduling after an enqueue, unless it's
+ * already there */
+static inline void sched_queue_lf_activate(queue_entry_t *queue)
+{
+	int status = QUEUE_STATUS_NOTSCHED;
+
+	/* Order ring enqueue before status load. Pairs with the barrier in
+	 * sched_queue_lf_deq(). */
+	odp_mb_full();
+
+	if (odp_likely(queue_status_load(queue) != QUEUE_STATUS_NOTSCHED))
+		return;
+
+	if (!queue_status_cas(queue, &status, QUEUE_STATUS_SCHED))
+		return;
+
+	if (_odp_sched_fn->sched_queue(queue->index))
+		_ODP_ABORT("schedule_queue failed\n");
+}
+
+static int sched_queue_lf_enq(odp_queue_t handle, _odp_event_hdr_t *event_hdr)
+{
+	queue_entry_t *queue = qentry_from_handle(handle);
+	int ret;
+
+	if (_odp_sched_fn->ord_enq_multi(handle, (void **)&event_hdr, 1, &ret))
+		return ret == 1 ? 0 : -1;
+
+	if (odp_unlikely(ring_mpmc_ptr_enq(&queue->ring_mpmc, queue->ring_data, queue->ring_mask,
+					   (uintptr_t)event_hdr) == 0))
+		return -1;
+
+	sched_queue_lf_activate(queue);
+
+	return 0;
+}
+
+static int sched_queue_lf_enq_multi(odp_queue_t handle, _odp_event_hdr_t *event_hdr[], int num)
+{
+	queue_entry_t *queue = qentry_from_handle(handle);
+	uint32_t num_enq;
+	int ret;
+
+	if (_odp_sched_fn->ord_enq_multi(handle, (void **)event_hdr, num, &ret))
+		return ret;
+
+	num_enq = ring_mpmc_ptr_enq_multi(&queue->ring_mpmc, queue->ring_data, queue->ring_mask,
+					  (uintptr_t *)event_hdr, num);
+
+	if (odp_unlikely(num_enq == 0))
+		return 0;
+
+	sched_queue_lf_activate(queue);
+
+	return num_enq;
+}
+
+/* Finish destroy of a queue that was in scheduling when destroyed */
+static void sched_queue_lf_destroyed(queue_entry_t *queue)
+{
+	LOCK(queue);
+
+	if (queue->status == QUEUE_STATUS_DESTROYED) {
+		__atomic_store_n(&queue->status, QUEUE_STATUS_FREE, __ATOMIC_RELEASE);
+		_odp_sched_fn->destroy_queue(queue->index);
+	}
+
+	UNLOCK(queue);
+}
+
+/* Remove an empty lock-free queue from scheduling. Returns 1 when removed,
+ * 0 when the queue needs to stay in scheduling, or -1 when the queue has
+ * been destroyed. */
+static inline int sched_queue_lf_deactivate(queue_entry_t *queue)
+{
+	int status = QUEUE_STATUS_SCHED;
+
+	if (!queue_status_cas(queue, &status, QUEUE_STATUS_NOTSCHED)) {
+		if (status == QUEUE_STATUS_DESTROYED) {
+			sched_queue_lf_destroyed(queue);
+			return -1;
+		}
+
+		return 1;
+	}
+
+	/* Order status store before ring load. Pairs with the barrier in
+	 * sched_queue_lf_activate(). */
+	odp_mb_full();
+
+	if (odp_likely(ring_mpmc_ptr_is_empty(&queue->ring_mpmc)))
+		return 1;
+
+	/* An enqueue raced with the status update. Put the queue back into
+	 * scheduling, unless the enqueuer already did that. */
+	status = QUEUE_STATUS_NOTSCHED;
+	if (queue_status_cas(queue, &status, QUEUE_STATUS_SCHED))
+		return 0;
+
+	return 1;
+}
+
+static int sched_queue_lf_deq(queue_entry_t *queue, odp_event_t ev[], int max_num,
+			      int update_status)
+{
+	uint32_t num_deq;
+	int ret;
+
+	if (odp_unlikely(queue_status_load(queue) < QUEUE_STATUS_READY)) {
+		/* Bad queue, or queue has been destroyed.
+		 * Inform scheduler about a destroyed queue. */
+		sched_queue_lf_destroyed(queue);
+		return -1;
+	}
+
+	while (1) {
+		num_deq = ring_mpmc_ptr_deq_multi(&queue->ring_mpmc, queue->ring_data,
+						  queue->ring_mask, (uintptr_t *)ev, max_num);
+
+		if (num_deq)
+			break;
+
+		/* Already empty queue */
+		if (!update_status)
+			return 0;
+
+		ret = sched_queue_lf_deactivate(queue);
+		if (ret)
+			return ret < 0 ? -1 : 0;
+	}
+
+	for (uint32_t i = 0; i < num_deq; i++)
+		odp_prefetch((void *)ev[i]);
+
+	return num_deq;
+}
+
 int _odp_sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int max_num,
 			 int update_status)
 {
@@ -946,6 +1281,9 @@ int _odp_sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int max_num,
 	uint32_t num_deq;
 	int status;
 
+	if (_odp_queue_glb->config.sched_queue_lockfree)
+		return sched_queue_lf_deq(queue, ev, max_num, update_status);
+
 	LOCK(queue);
 
 	status = queue->status;
@@ -988,6 +1326,17 @@ int _odp_sched_queue_empty(uint32_t queue_index)
 	queue_entry_t *queue = qentry_from_index(queue_index);
 	int ret = 0;
 
+	if (_odp_queue_glb->config.sched_queue_lockfree) {
+		if (odp_unlikely(queue_status_load(queue) < QUEUE_STATUS_READY))
+			return -1;
+
+		if (!ring_mpmc_ptr_is_empty(&queue->ring_mpmc))
+			return 0;
+
+		ret = sched_queue_lf_deactivate(queue);
+		return ret < 0 ? -1 : ret;
+	}
+
 	LOCK(queue);
 
 	if (odp_unlikely(queue->status < QUEUE_STATUS_READY)) {
@@ -1061,6 +1410,7 @@ static int queue_init(queue_entry_t *queue, const char *name,
 
 	queue->spsc = spsc;
 	queue->queue_lf = NULL;
+	queue->num_flow_queue = 0;
 
 	/* Default to error functions */
 	queue->enqueue            = error_enqueue;
@@ -1083,6 +1433,13 @@ static int queue_init(queue_entry_t *queue, const char *name,
 			queue->ring_mask = queue_size - 1;
 			ring_mpmc_ptr_init(&queue->ring_mpmc);
 
+		} else if (_odp_queue_glb->config.sched_queue_lockfree) {
+			queue->enqueue            = sched_queue_lf_enq;
+			queue->enqueue_multi      = sched_queue_lf_enq_multi;
+
+			queue->ring_data = &_odp_queue_glb->ring_data[offset];
+			queue->ring_mask = queue_size - 1;
+			ring_mpmc_ptr_init(&queue->ring_mpmc);
 		} else {
 			queue->enqueue            = sched_queue_enq;
 			queue->enqueue_multi      = sched_queue_enq_multi;
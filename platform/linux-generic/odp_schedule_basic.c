@@ -25,9 +25,12 @@
 #include <odp/api/ticketlock.h>
 #include <odp/api/hints.h>
 #include <odp/api/cpu.h>
+#include <odp/api/event.h>
 #include <odp/api/thrmask.h>
 #include <odp_config_internal.h>
+#include <odp_crypto_internal.h>
 #include <odp/api/sync.h>
+#include <odp/api/packet.h>
 #include <odp/api/packet_io.h>
 #include <odp_ring_mpmc_rst_u32_internal.h>
 #include <odp_timer_internal.h>
@@ -88,6 +91,9 @@ ODP_STATIC_ASSERT((QUEUE_LOAD * CONFIG_MAX_SCHED_QUEUES) < UINT32_MAX, "Load_val
 #define MIN_PREFER_WEIGHT 1
 #define MAX_PREFER_RATIO  (MAX_PREFER_WEIGHT + 1)
 
+/* Maximum weight of a priority level in weighted priority mode */
+#define MAX_PRIO_WEIGHT 0xffff
+
 /* Spread weight table */
 #define SPREAD_TBL_SIZE ((MAX_SPREAD - 1) * MAX_PREFER_RATIO)
 
@@ -133,6 +139,12 @@ ODP_STATIC_ASSERT((8 * sizeof(prio_q_mask_t)) >= MAX_SPREAD,
 /* Ordered stash size */
 #define MAX_ORDERED_STASH 512
 
+/* Maximum size of ordered context release window */
+#define MAX_ORDER_WINDOW 64
+
+/* Number of stash sets per thread for contexts waiting in release windows */
+#define ORDER_SETS 4
+
 /* Storage for stashed enqueue operation arguments */
 typedef struct {
 	_odp_event_hdr_t *event_hdr[QUEUE_MULTI_MAX];
@@ -149,6 +161,16 @@ typedef union {
 ODP_STATIC_ASSERT(sizeof(lock_called_t) == sizeof(uint32_t),
 		  "Lock_called_values_do_not_fit_in_uint32");
 
+/* Stashed enqueue operations of an ordered context that was released out of
+ * order. Owned by a thread, but released by the thread that is in order. */
+typedef struct ODP_ALIGNED_CACHE {
+	/* Set is waiting in a release window */
+	odp_atomic_u32_t busy;
+	int stash_num;
+	lock_called_t lock_called;
+	ordered_stash_t stash[];
+} order_set_t;
+
 /* Shuffled values from 0 to 127 */
 static uint8_t sched_random_u8[] = {
 	0x5B, 0x56, 0x21, 0x28, 0x77, 0x2C, 0x7E, 0x10,
@@ -197,6 +219,10 @@ typedef struct ODP_ALIGNED_CACHE {
 	uint8_t grp[NUM_SCHED_GRPS];
 	uint8_t spread_tbl[SPREAD_TBL_SIZE];
 
+	/* Remaining number of events per priority level in the current weighted
+	 * priority round */
+	int32_t prio_deficit[NUM_PRIO];
+
 	struct {
 		/* Source queue index */
 		uint32_t src_queue;
@@ -234,6 +260,9 @@ typedef struct ODP_ALIGNED_CACHE {
 	/* Array of ordered locks */
 	odp_atomic_u64_t lock[CONFIG_QUEUE_MAX_ORD_LOCKS];
 
+	/* Release window: order set index + 1 per context, or 0 */
+	odp_atomic_u32_t window[MAX_ORDER_WINDOW];
+
 } order_context_t;
 
 typedef struct {
@@ -241,6 +270,12 @@ typedef struct {
 		uint8_t burst_default[NUM_SCHED_SYNC][NUM_PRIO];
 		uint8_t burst_max[NUM_SCHED_SYNC][NUM_PRIO];
 		uint16_t order_stash_size;
+		uint16_t order_window;
+		uint8_t burst_adaptive;
+		uint8_t flow_queues;
+		uint8_t prefetch;
+		uint8_t prio_weighted;
+		uint16_t prio_weight[NUM_PRIO];
 		uint8_t num_spread;
 		uint8_t prefer_ratio;
 	} config;
@@ -265,6 +300,10 @@ typedef struct {
 		uint8_t poll_pktin;
 		uint8_t pktio_index;
 		uint8_t pktin_index;
+		/* Index of the queue handle returned to application */
+		uint16_t handle_index;
+		/* Adaptive burst size */
+		uint8_t burst;
 	} queue[CONFIG_MAX_SCHED_QUEUES];
 
 	/* Scheduler priority queues */
@@ -296,6 +335,14 @@ typedef struct {
 
 	order_context_t order[CONFIG_MAX_SCHED_QUEUES];
 
+	struct {
+		odp_shm_t shm;
+		uint8_t *set;
+		uint32_t set_size;
+		uint32_t num_set;
+		uint32_t mask;
+	} order_win;
+
 	struct {
 		uint32_t poll_time;
 		uint64_t sleep_time;
@@ -400,6 +447,44 @@ static int read_burst_size_conf(uint8_t out_tbl[], const char *conf_str,
 	return 0;
 }
 
+static int read_prio_weight_conf(sched_global_t *sched)
+{
+	const char *str = "sched_basic.prio_weight";
+	int weight[NUM_PRIO];
+	int num_zero = 0;
+
+	if (_odp_libconfig_lookup_array(str, weight, NUM_PRIO) != NUM_PRIO) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	_ODP_PRINT("  %s[]:", str);
+
+	for (int i = 0; i < NUM_PRIO; i++) {
+		if (weight[i] > MAX_PRIO_WEIGHT || weight[i] < 0) {
+			_ODP_ERR("Bad value for %s: %i\n", str, weight[i]);
+			return -1;
+		}
+
+		if (weight[i] == 0)
+			num_zero++;
+
+		sched->config.prio_weight[i] = weight[i];
+		_ODP_PRINT(" %i", weight[i]);
+	}
+	_ODP_PRINT("\n");
+
+	/* Weights are either all zero (strict priority) or all non-zero */
+	if (num_zero != 0 && num_zero != NUM_PRIO) {
+		_ODP_ERR("Bad value for %s: mixed zero and non-zero weights\n", str);
+		return -1;
+	}
+
+	sched->config.prio_weighted = (num_zero == 0);
+
+	return 0;
+}
+
 static int read_config_file(sched_global_t *sched)
 {
 	const char *str;
@@ -453,6 +538,9 @@ static int read_config_file(sched_global_t *sched)
 	if (val == 0 || sched->config.num_spread == 1)
 		sched->load_balance = 0;
 
+	if (read_prio_weight_conf(sched))
+		return -1;
+
 	str = "sched_basic.order_stash_size";
 	if (!_odp_libconfig_lookup_int(str, &val)) {
 		_ODP_ERR("Config option '%s' not found.\n", str);
@@ -467,6 +555,40 @@ static int read_config_file(sched_global_t *sched)
 	sched->config.order_stash_size = val;
 	_ODP_PRINT("  %s: %i\n", str, val);
 
+	str = "sched_basic.order_release_window";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_ORDER_WINDOW || val < 0 || (val && !_ODP_CHECK_IS_POWER2(val))) {
+		_ODP_ERR("Bad value %s = %i [min: 0, max: %u, power of two]\n", str, val,
+			 MAX_ORDER_WINDOW);
+		return -1;
+	}
+
+	/* Contexts are released out of order only through the stash */
+	if (sched->config.order_stash_size == 0 || val == 1)
+		val = 0;
+
+	sched->config.order_window = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.flow_queues";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_FLOW_QUEUES || val < 0 || (val && !_ODP_CHECK_IS_POWER2(val))) {
+		_ODP_ERR("Bad value %s = %i [min: 0, max: %u, power of two]\n", str, val,
+			 MAX_FLOW_QUEUES);
+		return -1;
+	}
+
+	sched->config.flow_queues = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	/* Initialize default values for all queue types */
 	str = "sched_basic.burst_size_default";
 	if (read_burst_size_conf(sched->config.burst_default[ODP_SCHED_SYNC_ATOMIC], str, 1,
@@ -510,6 +632,29 @@ static int read_config_file(sched_global_t *sched)
 				 "sched_basic.burst_size_max_ordered", 0, BURST_MAX, 1))
 		return -1;
 
+	str = "sched_basic.burst_adaptive";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > BURST_MAX || val < 0) {
+		_ODP_ERR("Bad value %s = %i [min: 0, max: %u]\n", str, val, BURST_MAX);
+		return -1;
+	}
+
+	sched->config.burst_adaptive = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.prefetch";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	sched->config.prefetch = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	str = "sched_basic.group_enable.all";
 	if (!_odp_libconfig_lookup_int(str, &val)) {
 		_ODP_ERR("Config option '%s' not found.\n", str);
@@ -583,6 +728,9 @@ static void sched_local_init(void)
 	sched_local.sync_ctx    = NO_SYNC_CONTEXT;
 	sched_local.stash.queue = ODP_QUEUE_INVALID;
 
+	for (i = 0; i < NUM_PRIO; i++)
+		sched_local.prio_deficit[i] = sched->config.prio_weight[i];
+
 	spread = spread_from_index(sched_local.thr);
 	prefer_ratio = sched->config.prefer_ratio;
 
@@ -598,6 +746,45 @@ static void sched_local_init(void)
 	}
 }
 
+static inline order_set_t *order_set_from_index(uint32_t idx)
+{
+	return (order_set_t *)(uintptr_t)(sched->order_win.set +
+					  (uint64_t)idx * sched->order_win.set_size);
+}
+
+static int order_window_init(void)
+{
+	odp_shm_t shm;
+	uint32_t i, set_size, num_set;
+
+	sched->order_win.shm = ODP_SHM_INVALID;
+
+	if (sched->config.order_window == 0)
+		return 0;
+
+	set_size = _ODP_ROUNDUP_CACHE_LINE(sizeof(order_set_t) + sched->config.order_stash_size *
+					   sizeof(ordered_stash_t));
+	num_set = odp_thread_count_max() * ORDER_SETS;
+
+	shm = odp_shm_reserve("_odp_sched_basic_order_win", (uint64_t)set_size * num_set,
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Schedule init: Order window shm reserve failed.\n");
+		return -1;
+	}
+
+	sched->order_win.shm = shm;
+	sched->order_win.set = odp_shm_addr(shm);
+	sched->order_win.set_size = set_size;
+	sched->order_win.num_set = num_set;
+	sched->order_win.mask = sched->config.order_window - 1;
+
+	for (i = 0; i < num_set; i++)
+		odp_atomic_init_u32(&order_set_from_index(i)->busy, 0);
+
+	return 0;
+}
+
 static int schedule_init_global(void)
 {
 	odp_shm_t shm;
@@ -627,6 +814,11 @@ static int schedule_init_global(void)
 	if (sched->config.order_stash_size == 0)
 		_odp_schedule_basic_fn.ord_enq_multi = schedule_ord_enq_multi_no_stash;
 
+	if (order_window_init()) {
+		odp_shm_free(shm);
+		return -1;
+	}
+
 	sched->shm = shm;
 	prefer_ratio = sched->config.prefer_ratio;
 
@@ -659,6 +851,9 @@ static int schedule_init_global(void)
 	if (sched->max_queues > CONFIG_MAX_SCHED_QUEUES)
 		sched->max_queues = CONFIG_MAX_SCHED_QUEUES;
 
+	/* In flow aware mode, an atomic queue uses also its flow queues */
+	sched->max_queues /= 1 + sched->config.flow_queues;
+
 	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
 		odp_ticketlock_init(&sched->mask_lock[grp]);
 
@@ -738,6 +933,12 @@ static int schedule_term_global(void)
 		}
 	}
 
+	if (sched->order_win.shm != ODP_SHM_INVALID &&
+	    odp_shm_free(sched->order_win.shm) < 0) {
+		_ODP_ERR("Shm free failed for order window\n");
+		rc = -1;
+	}
+
 	ret = odp_shm_free(sched->shm);
 	if (ret < 0) {
 		_ODP_ERR("Shm free failed for odp_scheduler");
@@ -903,6 +1104,7 @@ static int schedule_create_queue(uint32_t queue_index,
 				 const odp_schedule_param_t *sched_param)
 {
 	int i;
+	odp_queue_t flow_parent;
 	uint8_t spread;
 	int grp  = sched_param->group;
 	int prio = prio_level_from_api(sched_param->prio);
@@ -955,6 +1157,13 @@ static int schedule_create_queue(uint32_t queue_index,
 	sched->queue[queue_index].poll_pktin  = 0;
 	sched->queue[queue_index].pktio_index = 0;
 	sched->queue[queue_index].pktin_index = 0;
+	sched->queue[queue_index].handle_index = queue_index;
+	sched->queue[queue_index].burst = sched->config.burst_max[sched_param->sync][prio];
+
+	/* Events of a flow queue are returned from the flow aware queue */
+	flow_parent = qentry_from_index(queue_index)->flow_parent;
+	if (flow_parent != ODP_QUEUE_INVALID)
+		sched->queue[queue_index].handle_index = queue_to_index(flow_parent);
 
 	odp_atomic_init_u64(&sched->order[queue_index].ctx, 0);
 	odp_atomic_init_u64(&sched->order[queue_index].next_ctx, 0);
@@ -962,6 +1171,9 @@ static int schedule_create_queue(uint32_t queue_index,
 	for (i = 0; i < CONFIG_QUEUE_MAX_ORD_LOCKS; i++)
 		odp_atomic_init_u64(&sched->order[queue_index].lock[i], 0);
 
+	for (i = 0; i < MAX_ORDER_WINDOW; i++)
+		odp_atomic_init_u32(&sched->order[queue_index].window[i], 0);
+
 	return 0;
 }
 
@@ -1068,18 +1280,18 @@ static inline void wait_for_order(uint32_t queue_index)
  *
  * Should be called only when already in order.
  */
-static inline void ordered_stash_release(void)
+static inline void ordered_stash_enq(ordered_stash_t stash[], int stash_num)
 {
 	int i;
 
-	for (i = 0; i < sched_local.ordered.stash_num; i++) {
+	for (i = 0; i < stash_num; i++) {
 		odp_queue_t queue;
 		_odp_event_hdr_t **event_hdr;
 		int num, num_enq;
 
-		queue = sched_local.ordered.stash[i].queue;
-		event_hdr = sched_local.ordered.stash[i].event_hdr;
-		num = sched_local.ordered.stash[i].num;
+		queue = stash[i].queue;
+		event_hdr = stash[i].event_hdr;
+		num = stash[i].num;
 
 		num_enq = odp_queue_enq_multi(queue,
 					      (odp_event_t *)event_hdr, num);
@@ -1093,9 +1305,103 @@ static inline void ordered_stash_release(void)
 			_odp_event_free_multi(&event_hdr[num_enq], num - num_enq);
 		}
 	}
+}
+
+static inline void ordered_stash_release(void)
+{
+	ordered_stash_enq(sched_local.ordered.stash, sched_local.ordered.stash_num);
 	sched_local.ordered.stash_num = 0;
 }
 
+/*
+ * Leave current ordered context into the release window of the source queue
+ *
+ * Returns 1 when the context will be released by the thread that releases
+ * the preceding context, or 0 when the caller must wait for order and
+ * release the context itself.
+ */
+static inline int order_window_add(uint32_t qi)
+{
+	order_context_t *order = &sched->order[qi];
+	uint64_t ctx = sched_local.ordered.ctx;
+	odp_atomic_u32_t *slot;
+	order_set_t *set = NULL;
+	uint32_t i, idx, val;
+
+	if (ctx - odp_atomic_load_acq_u64(&order->ctx) > sched->order_win.mask)
+		return 0;
+
+	idx = sched_local.thr * ORDER_SETS;
+	for (i = 0; i < ORDER_SETS; i++, idx++) {
+		set = order_set_from_index(idx);
+
+		if (odp_atomic_load_acq_u32(&set->busy) == 0)
+			break;
+	}
+
+	if (i == ORDER_SETS)
+		return 0;
+
+	set->stash_num = sched_local.ordered.stash_num;
+	set->lock_called = sched_local.ordered.lock_called;
+	memcpy(set->stash, sched_local.ordered.stash,
+	       set->stash_num * sizeof(ordered_stash_t));
+	odp_atomic_store_u32(&set->busy, 1);
+
+	slot = &order->window[ctx & sched->order_win.mask];
+	odp_atomic_store_rel_u32(slot, idx + 1);
+
+	/* Order slot store before context load. Pairs with the barrier in
+	 * order_window_release(). */
+	odp_mb_full();
+
+	val = idx + 1;
+	if (odp_unlikely(ordered_own_turn(qi)) && odp_atomic_cas_u32(slot, &val, 0)) {
+		/* Previous context was released before the slot was seen */
+		odp_atomic_store_u32(&set->busy, 0);
+		return 0;
+	}
+
+	return 1;
+}
+
+/*
+ * Release contexts waiting in the release window
+ *
+ * Called after the queue context has been advanced to 'ctx'.
+ */
+static inline void order_window_release(uint32_t qi, uint64_t ctx)
+{
+	order_context_t *order = &sched->order[qi];
+	uint32_t i;
+
+	while (1) {
+		odp_atomic_u32_t *slot = &order->window[ctx & sched->order_win.mask];
+		order_set_t *set;
+		uint32_t val;
+
+		/* Order context store before slot load */
+		odp_mb_full();
+
+		val = odp_atomic_load_u32(slot);
+		if (val == 0 || !odp_atomic_cas_acq_u32(slot, &val, 0))
+			return;
+
+		set = order_set_from_index(val - 1);
+
+		for (i = 0; i < sched->queue[qi].order_lock_count; i++) {
+			if (!set->lock_called.u8[i])
+				odp_atomic_store_rel_u64(&order->lock[i], ctx + 1);
+		}
+
+		ordered_stash_enq(set->stash, set->stash_num);
+		odp_atomic_store_rel_u32(&set->busy, 0);
+
+		ctx++;
+		odp_atomic_store_rel_u64(&order->ctx, ctx);
+	}
+}
+
 static inline void release_ordered(void)
 {
 	uint32_t qi;
@@ -1103,6 +1409,14 @@ static inline void release_ordered(void)
 
 	qi = sched_local.ordered.src_queue;
 
+	if (sched->config.order_window && !ordered_own_turn(qi) && order_window_add(qi)) {
+		sched_local.ordered.lock_called.all = 0;
+		sched_local.ordered.in_order = 0;
+		sched_local.ordered.stash_num = 0;
+		sched_local.sync_ctx = NO_SYNC_CONTEXT;
+		return;
+	}
+
 	wait_for_order(qi);
 
 	/* Release all ordered locks */
@@ -1122,6 +1436,9 @@ static inline void release_ordered(void)
 
 	/* Next thread can continue processing */
 	odp_atomic_add_rel_u64(&sched->order[qi].ctx, 1);
+
+	if (sched->config.order_window)
+		order_window_release(qi, sched_local.ordered.ctx + 1);
 }
 
 static void schedule_release_ordered(void)
@@ -1307,6 +1624,7 @@ static int schedule_config(const odp_schedule_config_t *config)
 	sched->config_if.max_prio = max_prio;
 	sched->config_if.def_prio = (sched->config_if.max_prio - sched->config_if.min_prio) / 2 +
 				    sched->config_if.min_prio;
+	sched->config_if.num_flow_queues = config->max_flow_id ? sched->config.flow_queues : 0;
 
 	for (int i = 0; i < NUM_SCHED_GRPS; i++) {
 		for (uint32_t j = 0; j < sched->config_if.max_prios; ++j)
@@ -1540,8 +1858,25 @@ static inline int poll_pktin(uint32_t qi, int direct_recv,
 	return ret;
 }
 
+/* Update adaptive burst size of a queue. A full burst indicates that more
+ * events are waiting in the queue, and a partial burst that the queue was
+ * drained. Burst size is not reduced due to application limiting 'max_deq'. */
+static inline void burst_adapt(uint32_t qi, uint32_t num, uint32_t max_deq, uint32_t burst_max)
+{
+	uint32_t burst = sched->queue[qi].burst;
+	uint32_t new_burst = burst;
+
+	if (num == burst)
+		new_burst = _ODP_MIN(2 * burst, burst_max);
+	else if (num < max_deq / 2)
+		new_burst = _ODP_MAX(max_deq / 2, sched->config.burst_adaptive);
+
+	if (new_burst != burst)
+		sched->queue[qi].burst = new_burst;
+}
+
 static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[], uint32_t max_num,
-				    int grp, int prio, int first_spr, int balance)
+				    int grp, int prio, int first_spr, int balance, int prefetch)
 {
 	int spr, new_spr, i, ret;
 	uint32_t qi;
@@ -1593,12 +1928,22 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 		ordered  = (sync_ctx == ODP_SCHED_SYNC_ORDERED);
 		max_deq = burst_def_sync[sync_ctx];
 
+		/* Ordered queues are not prefetched, since an ordered context would
+		 * affect enqueues of the events application is still processing. */
+		if (odp_unlikely(prefetch && ordered)) {
+			ring_mpmc_rst_u32_enq(ring, ring_mask, qi);
+			i++;
+			spr++;
+			continue;
+		}
+
 		/* When application's array is larger than default burst
 		 * size, output all events directly there. Also, ordered
 		 * queues are not stashed locally to improve
 		 * parallelism. Ordered context can only be released
-		 * when the local cache is empty. */
-		if (max_num > max_deq || ordered) {
+		 * when the local cache is empty. Prefetched events are
+		 * always stashed. */
+		if (!prefetch && (max_num > max_deq || ordered)) {
 			const uint32_t burst_max = burst_max_sync[sync_ctx];
 
 			stashed = 0;
@@ -1608,6 +1953,9 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 				max_deq = burst_max;
 		}
 
+		if (sched->config.burst_adaptive && max_deq > sched->queue[qi].burst)
+			max_deq = sched->queue[qi].burst;
+
 		pktin = queue_is_pktin(qi);
 
 		/* Update queue spread before dequeue. Dequeue changes status of an empty
@@ -1631,6 +1979,9 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			continue;
 		}
 
+		if (sched->config.burst_adaptive)
+			burst_adapt(qi, num, max_deq, burst_max_sync[sync_ctx]);
+
 		if (num == 0) {
 			int direct_recv = !ordered;
 			int num_pkt;
@@ -1664,6 +2015,10 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			num = num_pkt;
 		}
 
+		/* Consume priority level quantum of the current round */
+		if (sched->config.prio_weighted)
+			sched_local.prio_deficit[prio] -= num;
+
 		if (ordered) {
 			uint64_t ctx;
 			odp_atomic_u64_t *next_ctx;
@@ -1688,12 +2043,17 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			ring_mpmc_rst_u32_enq(ring, ring_mask, qi);
 		}
 
-		handle = queue_from_index(qi);
+		handle = queue_from_index(sched->queue[qi].handle_index);
 
 		if (stashed) {
 			sched_local.stash.num_ev   = num;
 			sched_local.stash.ev_index = 0;
 			sched_local.stash.queue    = handle;
+
+			/* Prefetched events are left into the stash */
+			if (odp_unlikely(prefetch))
+				return num;
+
 			ret = copy_from_stash(out_ev, max_num);
 		} else {
 			sched_local.stash.num_ev = 0;
@@ -1710,12 +2070,106 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 	return 0;
 }
 
+static inline int schedule_prio(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t max_num,
+				int prio, uint64_t my_groups, int first_id, int num_grp, int spr,
+				int balance, int prefetch)
+{
+	int i, ret, grp;
+	int grp_id = first_id;
+
+	if (prio_grp_mask_check(prio, my_groups) == 0) {
+		/* My groups do not have queues at this priority level, continue to
+		 * the next level.
+		 *
+		 * As a performance optimization, prio_grp_mask[] is checked without
+		 * taking the lock. Masks change infrequently and usage of an old mask
+		 * just leads into searching events from old priority levels,
+		 * new levels are likely used on the next schedule call. */
+		return 0;
+	}
+
+	for (i = 0; i < num_grp; i++) {
+		grp = sched_local.grp[grp_id];
+
+		grp_id++;
+		if (odp_unlikely(grp_id >= num_grp))
+			grp_id = 0;
+
+		if (sched->prio_q_mask[grp][prio] == 0) {
+			/* Group does not have queues at this priority level */
+			continue;
+		}
+
+		/* Schedule events from the selected group and priority level */
+		ret = schedule_grp_prio(out_q, out_ev, max_num, grp, prio, spr, balance, prefetch);
+
+		if (odp_likely(ret))
+			return ret;
+	}
+
+	return 0;
+}
+
+/*
+ * Deficit weighted round robin over priority levels. Each thread serves a priority
+ * level until its weight worth of events have been scheduled from it, or it has no
+ * events. A new round starts when all levels with events have used their quantum.
+ * Deficit counters are thread local, so no synchronization is needed.
+ */
+static inline int schedule_weighted(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t max_num,
+				    uint64_t my_groups, int first_id, int num_grp, int spr,
+				    int balance, int prefetch)
+{
+	int prio, ret;
+	uint32_t skipped = 0;
+
+	for (prio = 0; prio < NUM_PRIO; prio++) {
+		if (sched_local.prio_deficit[prio] <= 0) {
+			skipped |= 1u << prio;
+			continue;
+		}
+
+		ret = schedule_prio(out_q, out_ev, max_num, prio, my_groups, first_id, num_grp,
+				    spr, balance, prefetch);
+
+		if (ret)
+			return ret;
+	}
+
+	if (skipped == 0)
+		return 0;
+
+	/* Start a new round. Levels that exceeded their quantum (due to burst
+	 * dequeue) carry the excess over to the new round. */
+	for (prio = 0; prio < NUM_PRIO; prio++) {
+		if (sched_local.prio_deficit[prio] < 0)
+			sched_local.prio_deficit[prio] += sched->config.prio_weight[prio];
+		else
+			sched_local.prio_deficit[prio] = sched->config.prio_weight[prio];
+	}
+
+	/* Check levels that were skipped due to used up quantum */
+	for (prio = 0; prio < NUM_PRIO; prio++) {
+		if ((skipped & (1u << prio)) == 0)
+			continue;
+
+		ret = schedule_prio(out_q, out_ev, max_num, prio, my_groups, first_id, num_grp,
+				    spr, balance, prefetch);
+
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
 /*
  * Schedule queues
  */
-static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t max_num)
+static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t max_num,
+			      int prefetch)
 {
-	int i, num_grp, ret, spr, first_id, grp_id, grp, prio;
+	int num_grp, ret, spr, first_id, prio;
 	uint32_t sched_round;
 	uint16_t spread_round;
 	uint32_t epoch;
@@ -1784,38 +2238,16 @@ static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t
 	first_id = sched_local.grp_idx;
 	sched_local.grp_idx = (first_id + 1) % num_grp;
 
-	for (prio = 0; prio < NUM_PRIO; prio++) {
-		grp_id = first_id;
-
-		if (prio_grp_mask_check(prio, my_groups) == 0) {
-			/* My groups do not have queues at this priority level, continue to
-			 * the next level.
-			 *
-			 * As a performance optimization, prio_grp_mask[] is checked without
-			 * taking the lock. Masks change infrequently and usage of an old mask
-			 * just leads into searching events from old priority levels,
-			 * new levels are likely used on the next schedule call. */
-			continue;
-		}
-
-		for (i = 0; i < num_grp; i++) {
-			grp = sched_local.grp[grp_id];
-
-			grp_id++;
-			if (odp_unlikely(grp_id >= num_grp))
-				grp_id = 0;
-
-			if (sched->prio_q_mask[grp][prio] == 0) {
-				/* Group does not have queues at this priority level */
-				continue;
-			}
+	if (odp_unlikely(sched->config.prio_weighted))
+		return schedule_weighted(out_q, out_ev, max_num, my_groups, first_id, num_grp, spr,
+					 balance, prefetch);
 
-			/* Schedule events from the selected group and priority level */
-			ret = schedule_grp_prio(out_q, out_ev, max_num, grp, prio, spr, balance);
+	for (prio = 0; prio < NUM_PRIO; prio++) {
+		ret = schedule_prio(out_q, out_ev, max_num, prio, my_groups, first_id, num_grp,
+				    spr, balance, prefetch);
 
-			if (odp_likely(ret))
-				return ret;
-		}
+		if (odp_likely(ret))
+			return ret;
 	}
 
 	return 0;
@@ -1824,8 +2256,9 @@ static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t
 static inline int schedule_run(odp_queue_t *out_queue, odp_event_t out_ev[], uint32_t max_num)
 {
 	timer_run(1);
+	crypto_compl_poll();
 
-	return do_schedule(out_queue, out_ev, max_num);
+	return do_schedule(out_queue, out_ev, max_num, 0);
 }
 
 static inline int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
@@ -1836,7 +2269,8 @@ static inline int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 	int ret;
 
 	while (1) {
-		ret = do_schedule(out_queue, out_ev, max_num);
+		crypto_compl_poll();
+		ret = do_schedule(out_queue, out_ev, max_num, 0);
 		if (ret) {
 			timer_run(2);
 			break;
@@ -1870,7 +2304,8 @@ static inline int schedule_loop_sleep(odp_queue_t *out_queue, uint64_t wait,
 	int first = 1, sleep = 0;
 
 	while (1) {
-		ret = do_schedule(out_queue, out_ev, max_num);
+		crypto_compl_poll();
+		ret = do_schedule(out_queue, out_ev, max_num, 0);
 		if (ret) {
 			timer_run(2);
 			break;
@@ -2456,7 +2891,33 @@ static int schedule_thr_rem(odp_schedule_group_t group, int thr)
 
 static void schedule_prefetch(int num)
 {
-	(void)num;
+	odp_event_t *ev;
+	int i;
+
+	if (odp_unlikely(num <= 0))
+		return;
+
+	if (sched_local.stash.num_ev == 0) {
+		/* Pre-schedule the next burst into the local stash. Only when not
+		 * holding an atomic or ordered context, so that context status of
+		 * the current events is not changed. Event headers are prefetched
+		 * on dequeue. */
+		if (!sched->config.prefetch || sched_local.sync_ctx != NO_SYNC_CONTEXT)
+			return;
+
+		do_schedule(NULL, NULL, 0, 1);
+	}
+
+	if ((uint32_t)num > sched_local.stash.num_ev)
+		num = sched_local.stash.num_ev;
+
+	/* Prefetch packet data of the stashed events */
+	ev = &sched_local.stash.ev[sched_local.stash.ev_index];
+
+	for (i = 0; i < num; i++) {
+		if (odp_event_type(ev[i]) == ODP_EVENT_PACKET)
+			odp_prefetch(odp_packet_data(odp_packet_from_event(ev[i])));
+	}
 }
 
 static void schedule_get_config(schedule_config_t *config)
@@ -25,6 +25,7 @@
 #include <odp_schedule_if.h>
 #include <odp_debug_internal.h>
 #include <odp_config_internal.h>
+#include <odp_crypto_internal.h>
 #include <odp_event_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_ring_mpmc_rst_u32_internal.h>
@@ -806,6 +807,7 @@ static int schedule_multi(odp_queue_t *from, uint64_t wait,
 		uint32_t qi;
 		int num;
 
+		crypto_compl_poll();
 		cmd = sched_cmd();
 
 		if (cmd && cmd->type == CMD_PKTIO) {